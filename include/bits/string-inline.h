@@ -0,0 +1,236 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _BITS_STRING_INLINE_H
+#define _BITS_STRING_INLINE_H
+/* This file is included by <string.h> unless `_SLIBC_NO_INLINE`
+ * is defined, and only when compiling with optimisation in GCC.
+ * It replaces calls, whose arguments are such that the call can
+ * be completed in a few instructions, with inline code, and
+ * leaves all other calls to the library.
+ * 
+ * Whether an argument is constant is tested with
+ * `__builtin_constant_p`, which never evaluates its argument.
+ * Every argument is evaluated exactly once, regardless of
+ * which branch is taken. The unparenthesised name of a function
+ * is not expanded again, so `(memcpy)(...)` calls the library.
+ * 
+ * `strcmp`, `strlen`, `memset` and `memcpy`, and `strstarts`
+ * and `strends` with `_SLIBC_SOURCE`, are function-like macros.
+ * Code that declares or defines any of these functions itself
+ * must `#undef` it after including <string.h>, or write its
+ * name in parentheses, as in `size_t (strlen)(const char*);`,
+ * or define `_SLIBC_NO_INLINE` before including <string.h>.
+ * Taking the address of a function is not affected.
+ * 
+ * `memcmp` is not replaced: GCC already expands `memcmp`
+ * with a small constant size when only equality is tested,
+ * and calls the library when the order is needed, and
+ * `__builtin_memcmp` does the same. */
+
+
+
+/**
+ * The greatest constant size, of a memory segment or a
+ * string, for which a call is replaced with inline code.
+ */
+#define __SLIBC_INLINE_MAX  64
+
+/**
+ * Check whether an expression is a string with constant
+ * length, no longer than `__SLIBC_INLINE_MAX`.
+ * 
+ * @param   s  The string.
+ * @return     Whether the length of `s` is a small constant.
+ */
+#define __slibc_inline_str(s)  \
+  (__builtin_constant_p(__builtin_strlen(s)) && (__builtin_strlen(s) <= __SLIBC_INLINE_MAX))
+
+/**
+ * Check whether an expression is a constant size,
+ * no greater than `__SLIBC_INLINE_MAX`.
+ * 
+ * @param   n  The size.
+ * @return     Whether `n` is a small constant.
+ */
+#define __slibc_inline_size(n)  \
+  (__builtin_constant_p(n) && ((n) <= __SLIBC_INLINE_MAX))
+
+
+
+/**
+ * Compare a string with a string of constant length.
+ * 
+ * Bytes are compared one at a time and the comparison stops
+ * at the first difference, so nothing after the terminating
+ * NUL byte of `a` is read. The loop is unrolled completely,
+ * as `n` is constant.
+ * 
+ * @param   a  A negative value is returned if this is the lesser.
+ * @param   b  A positive value is returned if this is the lesser.
+ * @param   n  The length of `b`.
+ * @return     Zero is returned if `a` and `b` are equal, otherwise,
+ *             see the specifications for `a` and `b`.
+ */
+static __inline__ __attribute__((__always_inline__, __pure__, __unused__))
+int __slibc_strcmp_n(const char* __a, const char* __b, size_t __n)
+{
+  size_t __i;
+#if __GNUC__ >= 8
+# pragma GCC unroll 65
+#endif
+  for (__i = 0; __i <= __n; __i++)
+    if (__a[__i] != __b[__i])
+      return (int)(unsigned char)__a[__i] - (int)(unsigned char)__b[__i];
+  return 0;
+}
+
+/**
+ * Compare two strings alphabetically in a case sensitive manner.
+ * 
+ * @param   a  A negative value is returned if this is the lesser.
+ * @param   b  A positive value is returned if this is the lesser.
+ * @return     Zero is returned if `a` and `b` are equal, otherwise,
+ *             see the specifications for `a` and `b`.
+ */
+#define strcmp(a, b)							\
+  (__slibc_inline_str(b) ? __slibc_strcmp_n(a, b, __builtin_strlen(b)) :	\
+   __slibc_inline_str(a) ? -__slibc_strcmp_n(b, a, __builtin_strlen(a)) :	\
+   (strcmp)(a, b))
+
+/**
+ * Calculate the length of a string.
+ * 
+ * @param   str  The string.
+ * @return       The number of bytes before the first NUL byte.
+ */
+#define strlen(str)  \
+  (__builtin_constant_p(__builtin_strlen(str)) ? __builtin_strlen(str) : (strlen)(str))
+
+/**
+ * Override a memory segment with a repeated character.
+ * 
+ * @param   segment  The beginning of the memory segment.
+ * @param   c        The character (8 bits wide.)
+ * @param   size     The size of the memory segment.
+ * @return           `segment` is returned.
+ */
+#define memset(segment, c, size)  \
+  (__slibc_inline_size(size) ? __builtin_memset(segment, c, size) : (memset)(segment, c, size))
+
+/**
+ * Copy a memory segment to another, non-overlapping, segment.
+ * 
+ * @param   whither  The destination memory segment.
+ * @param   whence   The source memory segment.
+ * @param   size     The number of bytes to copy.
+ * @return           `whither` is returned.
+ */
+#define memcpy(whither, whence, size)  \
+  (__slibc_inline_size(size) ? __builtin_memcpy(whither, whence, size) : (memcpy)(whither, whence, size))
+
+
+
+#if defined(__SLIBC_SOURCE)
+/**
+ * Check whether a string starts with a string of constant length.
+ * 
+ * Bytes are compared one at a time and the comparison stops
+ * at the first difference, so nothing after the terminating
+ * NUL byte of `string` is read.
+ * 
+ * @param   string   The string to inspect.
+ * @param   desired  The desired beginning of the string.
+ * @param   n        The length of `desired`.
+ * @return           `string` if `string` begins with
+ *                   `desired`, `NULL` otherwise.
+ */
+static __inline__ __attribute__((__always_inline__, __pure__, __unused__))
+char* __slibc_strstarts_n(const char* __string, const char* __desired, size_t __n)
+{
+  size_t __i;
+#if __GNUC__ >= 8
+# pragma GCC unroll 65
+#endif
+  for (__i = 0; __i < __n; __i++)
+    if (__string[__i] != __desired[__i])
+      return NULL;
+  return (char*)(__UINTPTR_TYPE__)__string;
+}
+
+/**
+ * Check whether a string ends with a string of constant length.
+ * 
+ * @param   string   The string to inspect.
+ * @param   desired  The desired ending of the string.
+ * @param   n        The length of `desired`.
+ * @return           The end of `string` if `string` ends
+ *                   with `desired`, `NULL` otherwise.
+ */
+static __inline__ __attribute__((__always_inline__, __pure__, __unused__))
+char* __slibc_strends_n(const char* __string, const char* __desired, size_t __n)
+{
+  size_t __m = (strlen)(__string);
+  if (__m < __n)
+    return NULL;
+  if (__builtin_memcmp(__string + (__m - __n), __desired, __n))
+    return NULL;
+  return (char*)(__UINTPTR_TYPE__)(__string + __m);
+}
+
+/**
+ * Check whether a string starts with a specific string.
+ * This check is case sensitive.
+ * 
+ * @param   string   The string to inspect.
+ * @param   desired  The desired beginning of the string.
+ * @return           `string` if `string` begins with
+ *                   `desired`, `NULL` otherwise.
+ */
+# define __slibc_strstarts(string, desired)					\
+  (__slibc_inline_str(desired)							\
+   ? __slibc_strstarts_n(string, desired, __builtin_strlen(desired))		\
+   : (strstarts)(string, desired))
+
+/**
+ * Check whether a string ends with a specific string.
+ * This check is case sensitive.
+ * 
+ * @param   string   The string to inspect.
+ * @param   desired  The desired ending of the string.
+ * @return           The end of `string` if `string` ends
+ *                   with `desired`, `NULL` otherwise.
+ */
+# define __slibc_strends(string, desired)					\
+  (__slibc_inline_str(desired)							\
+   ? __slibc_strends_n(string, desired, __builtin_strlen(desired))		\
+   : (strends)(string, desired))
+
+# undef strstarts
+# undef strends
+# ifdef __CONST_CORRECT
+#  define strstarts(string, desired)  (__const_correct(__slibc_strstarts, string, desired))
+#  define strends(string, desired)    (__const_correct(__slibc_strends, string, desired))
+# else
+#  define strstarts(string, desired)  __slibc_strstarts(string, desired)
+#  define strends(string, desired)    __slibc_strends(string, desired)
+# endif
+#endif
+
+
+
+#endif
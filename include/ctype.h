@@ -48,7 +48,7 @@ int (isalnum)(int)  /* [0x30, 0x39], [0x41, 0x5A], [0x61, 0x7A] */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define isalnum(c)  \
-  ({ int __c = (c); (isalpha(__c) || isdigit(__c)); })
+  ({ int __an = (c); (isalpha(__an) || isdigit(__an)); })
 #endif
 
 
@@ -86,7 +86,7 @@ int (isblank)(int) /* ' ', '\t' */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 # if defined(__GNUC__)
 #  define isblank(c)  \
-  ({ int __c = (c); ((__c == ' ') || (__c == '\t')); })
+  ({ int __bc = (c); ((__bc == ' ') || (__bc == '\t')); })
 # endif
 #endif
 
@@ -107,7 +107,7 @@ int (iscntrl)(int)  /* [0x00, 0x1F], 0x7F */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined(__GNUC__)
 # define iscntrl(c)  \
-  ({ int __c = (c); (((unsigned)__c < ' ') || (__c == 0x7F)); })
+  ({ int __cc = (c); (((unsigned)__cc < ' ') || (__cc == 0x7F)); })
 #endif
 
 
@@ -191,7 +191,7 @@ int (ispunct)(int)  /* isprint && !isalnum && !isspace */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define ispunct(c)  \
-  ({ int __c = (c); (isprint(__c) && !isalnum(__c) && !isspace(__c)); })
+  ({ int __pc = (c); (isprint(__pc) && !isalnum(__pc) && !isspace(__pc)); })
 #endif
 
 
@@ -210,7 +210,7 @@ int (isspace)(int)  /* 0x20, [0x09, 0x0D] */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define isspace(c)  \
-  ({ int __c = (c); ((__c == ' ') || ((unsigned)(__c - '\t') < 5)); })
+  ({ int __sc = (c); ((__sc == ' ') || ((unsigned)(__sc - '\t') < 5)); })
 #endif
 
 
@@ -247,7 +247,7 @@ int (isxdigit)(int)  /* [0x30, 0x39], [0x41, 0x46], [0x61, 0x66] */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define isxdigit(c)  \
-  ({ int __c = (c); (isdigit(__c) && (tolower(__c) - 'a' < 6)); })
+  ({ int __xc = (c); (isdigit(__xc) || ((unsigned)(tolower(__xc) - 'a') < 6)); })
 #endif
 
 
@@ -269,7 +269,7 @@ int (tolower)(int)  /* [0x41, 0x5A] -> [0x61, 0x7A] */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define tolower(c)  \
-  ({ int __c = (int)(unsigned)(c); (islower(__c) ? (__c | 0x20) : __c; })
+  ({ int __lc = (int)(unsigned)(c); (isupper(__lc) ? (__lc | 0x20) : __lc); })
 #endif
 
 /**
@@ -289,7 +289,7 @@ int (toupper)(int)  /* [0x61, 0x7A] -> [0x41, 0x5A] */
   __GCC_ONLY(__attribute__((__const__, __warn_unused_result__)));
 #if defined (__GNUC__)
 # define toupper(c)  \
-  ({ int __c = (int)(unsigned)(c); (isupper(__c) ? (__c & ~0x20) : __c; })
+  ({ int __uc = (int)(unsigned)(c); (islower(__uc) ? (__uc & ~0x20) : __uc); })
 #endif
 
 
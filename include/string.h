@@ -37,6 +37,9 @@
 
 #define __NEED_size_t
 #define __NEED_locale_t
+#if defined(__SLIBC_SOURCE)
+# define __NEED_uintN_t
+#endif
 #include <bits/types.h>
 
 
@@ -185,6 +188,66 @@ size_t strnlen(const char*, size_t)
  */
 void* memset(void*, int, size_t);
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * Override a memory segment with a repeated 16-bit integer.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The beginning of the memory segment.
+ * @param   c        The integer.
+ * @param   count    The number of integers in the memory segment.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset16(void*, uint16_t, size_t);
+
+/**
+ * Override a memory segment with a repeated 32-bit integer.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The beginning of the memory segment.
+ * @param   c        The integer.
+ * @param   count    The number of integers in the memory segment.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset32(void*, uint32_t, size_t);
+
+/**
+ * Override a memory segment with a repeated 64-bit integer.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The beginning of the memory segment.
+ * @param   c        The integer.
+ * @param   count    The number of integers in the memory segment.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset64(void*, uint64_t, size_t);
+
+/**
+ * Override a memory segment with a repeated pattern.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment       The beginning of the memory segment.
+ * @param   size          The size of the memory segment.
+ * @param   pattern       The pattern, it must not overlap with `segment`.
+ * @param   pattern_size  The size of the pattern, the last repetition of
+ *                        the pattern is truncated if it does not fit.
+ * @return                `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset_pattern(void*, size_t, const void*, size_t);
+#endif
+
 /**
  * Copy a memory segment to another, non-overlapping, segment.
  * 
@@ -242,6 +305,116 @@ void* memmove(void*, const void*, size_t);
 void* mempmove(void*, const void*, size_t);
 #endif
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * Copy a memory segment to another, possibly overlapping, segment.
+ * 
+ * If the segments have the same offset into a page, and are
+ * large, the pages of the source are moved to the destination,
+ * rather than copied. This requires that both segments are in
+ * private anonymous mappings, which is the case for memory
+ * allocated with `malloc`, otherwise the segment is copied.
+ * Afterwards, the parts of the source that were not overwritten
+ * are filled with zeroes, or left as they were.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   whither  The destination memory segment.
+ * @param   whence   The source memory segment.
+ * @param   size     The number of bytes to copy.
+ * @return           `whither` is returned, `NULL` on error,
+ *                   in which case the contents of both
+ *                   segments are unspecified, and parts
+ *                   of them may have been unmapped.
+ * 
+ * @throws  Any error specified for mmap(2) or mremap(2).
+ * 
+ * @since  Always.
+ */
+void* memmove_pages(void*, void*, size_t);
+
+/**
+ * Swap the contents of two non-overlapping memory segments.
+ * 
+ * If the segments have the same offset into a page, and are
+ * large, their pages are swapped rather than copied. This
+ * requires that both segments are in private anonymous
+ * mappings, which is the case for memory allocated with `malloc`,
+ * otherwise the segments are copied.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        0 on success, -1 on error, in which case
+ *                the contents of both segments are unspecified,
+ *                and parts of them may have been unmapped.
+ * 
+ * @throws  Any error specified for mmap(2) or mremap(2).
+ * 
+ * @since  Always.
+ */
+int memswap_pages(void*, void*, size_t);
+
+/**
+ * Swap the contents of two non-overlapping memory segments.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  a     One of the memory segments.
+ * @param  b     The other memory segment.
+ * @param  size  The size of the segments.
+ * 
+ * @since  Always.
+ */
+void memswap(void*, void*, size_t);
+
+/**
+ * Reverse the order of the bytes in a memory segment.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memrev(void*, size_t);
+
+/**
+ * Reverse the order of the elements in an array.
+ * The bytes in each element are not reordered.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The array.
+ * @param   count    The number of elements.
+ * @param   width    The size of each element.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memrev_elem(void*, size_t, size_t);
+
+/**
+ * Rotate a memory segment to the left, so that
+ * the byte at index `shift` becomes the first byte.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   shift    The number of bytes to rotate by,
+ *                   it may be greater than `size`.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memrotate(void*, size_t, size_t);
+#endif
+
 /**
  * Copy a memory segment to another, non-overlapping, segment,
  * but stop if a specific byte is encountered.
@@ -684,6 +857,62 @@ char* strncat(char* restrict, const char* restrict, size_t)
 
 /* stpncat does not exsits because use of it would be very inefficient. */
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * Concatenate strings, with a separator between
+ * each of them, into a newly allocated string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   sep  The separator, `NULL` for none.
+ * @param   ...  The strings, terminated by `NULL`.
+ * @return       The new string. `NULL` is returned on error
+ *               and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+char* strjoin(const char*, ...)
+  __GCC_ONLY(__attribute__((__malloc__, __sentinel__, __warn_unused_result__)));
+
+/**
+ * Concatenate strings into a newly allocated string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   first  The first string, `NULL` for none.
+ * @param   ...    The rest of the strings, terminated by `NULL`.
+ * @return         The new string. `NULL` is returned on error
+ *                 and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+char* vstrcat(const char*, ...)
+  __GCC_ONLY(__attribute__((__malloc__, __sentinel__, __warn_unused_result__)));
+
+/**
+ * Concatenate an array of strings, with a separator
+ * between each of them, into a newly allocated string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   sep      The separator, `NULL` for none.
+ * @param   strings  The strings.
+ * @param   count    The number of elements in `strings`.
+ * @return           The new string. `NULL` is returned on error
+ *                   and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+char* strjoinv(const char*, const char* const*, size_t)
+  __GCC_ONLY(__attribute__((__malloc__, __warn_unused_result__)));
+#endif
+
 
 /**
  * Duplicate a string.
@@ -699,6 +928,28 @@ char* strncat(char* restrict, const char* restrict, size_t)
 char* strdup(const char*)
   __GCC_ONLY(__attribute__((__malloc__, __nonnull__, __warn_unused_result__)));
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * Get the canonical copy of a string. Equal strings
+ * have the same canonical copy, so interned strings
+ * can be compared by their addresses.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   string  The string.
+ * @return          The canonical copy of `string`, it is
+ *                  valid until the process exits. `NULL`
+ *                  is returned on error and `errno` is
+ *                  set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+const char* strintern(const char*)
+  __GCC_ONLY(__attribute__((__nonnull__, __warn_unused_result__)));
+#endif
+
 #if defined(__GNU_SOURCE)
 /**
  * Duplicate a string.
@@ -737,6 +988,28 @@ char* strndup(const char*, size_t)
  */
 void* memdup(const void*, size_t)
   __GCC_ONLY(__attribute__((__malloc__, __nonnull__, __warn_unused_result__)));
+
+/**
+ * Get the canonical copy of a memory segment. Equal
+ * segments have the same canonical copy, so interned
+ * segments can be compared by their addresses.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The canonical copy of `segment`, it is
+ *                   followed by a NUL byte, and it is valid
+ *                   until the process exits. `NULL` is
+ *                   returned on error and `errno` is set
+ *                   to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+const void* memintern(const void*, size_t)
+  __GCC_ONLY(__attribute__((__nonnull__, __warn_unused_result__)));
 #endif
 
 #if defined (__GNUC__)
@@ -1244,87 +1517,517 @@ void* memmem(const void*, size_t, const void*, size_t)
 #endif
 
 
-/* TODO Add case right-to-left substring searching functions. */
-
-
+#if defined(__SLIBC_SOURCE)
 /**
- * Returns length of the initial substring
- * that consists entirely of a set of specified
- * bytes.
+ * Finds the last occurrence of a substring.
+ * This search is case sensitive.
  * 
- * @param   string   The string.
- * @param   skipset  Bytes allowed in the substring.
- * @return           The length of the substring.
+ * This is a slibc extension.
+ * 
+ * @param   haystack  The string to search.
+ * @param   needle    The sought after substring.
+ * @return            Pointer to the last occurrence of the
+ *                    substring, `NULL` if not found.
  * 
  * @since  Always.
  */
-size_t strspn(const char*, const char*)
+char* strrstr(const char*, const char*)
   __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define strrstr(...)  (__const_correct(strrstr, __VA_ARGS__))
+# endif
 
 /**
- * Returns length of the initial substring
- * that consists entirely of the complement
- * of a set of specified bytes.
+ * Finds the last occurrence of a substring.
+ * This search is case insensitive.
  * 
- * @param   string   The string.
- * @param   stopset  Bytes disallowed in the substring.
- * @return           The length of the substring.
+ * This is a slibc extension.
+ * 
+ * @param   haystack  The string to search.
+ * @param   needle    The sought after substring.
+ * @return            Pointer to the last occurrence of the
+ *                    substring, `NULL` if not found.
  * 
  * @since  Always.
  */
-size_t strcspn(const char*, const char*)
+char* strrcasestr(const char*, const char*)
   __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define strrcasestr(...)  (__const_correct(strrcasestr, __VA_ARGS__))
+# endif
 
 /**
- * This function works like `strcspn`,
- * except it returns the pointer to the
- * location of the first found non-matching
- * byte.
+ * Finds the last occurrence of a substring.
+ * This search is case sensitive.
  * 
- * @param   string   The string.
- * @param   stopset  Bytes disallowed in the substring.
- * @return           A pointer to the first occurrence in
- *                   `string` of a byte found in `stopset`.
- *                   `NULL` is returned if none is found.
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @return                   Pointer to the last occurrence of
+ *                           the substring, `NULL` if not found.
  * 
  * @since  Always.
  */
-char* strpbrk(const char*, const char*)
-  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
-#ifdef __CONST_CORRECT
-# define strpbrk(...)  (__const_correct(strpbrk, __VA_ARGS__))
-#endif
-
+void* memrmem(const void*, size_t, const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define memrmem(...)  (__const_correct(memrmem, __VA_ARGS__))
+# endif
 
 /**
- * Tokenise a string.
+ * Finds the last occurrence of a substring.
+ * This search is case insensitive.
  * 
- * @param   string      The string to tokenise on the first,
- *                      `NULL` on subsequent calls.
- *                      All bytes found in `delimiters` will
- *                      be overriden with NUL bytes.
- * @param   delimiters  Delimiting bytes (not characters).
- * @return              The next non-empty string that does not
- *                      contain a byte from `delimiters`. The
- *                      returned string will be as long as possible.
- *                      `NULL` is returned the search as reached
- *                      the end of the string, and there therefore
- *                      are no more tokens.
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @return                   Pointer to the last occurrence of
+ *                           the substring, `NULL` if not found.
  * 
  * @since  Always.
  */
-char* strtok(char* restrict, const char* restrict)
-  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__(2))));
+void* memrcasemem(const void*, size_t, const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define memrcasemem(...)  (__const_correct(memrcasemem, __VA_ARGS__))
+# endif
 
 /**
- * Tokenise a string.
+ * A needle prepared for searching,
+ * see `memmem_compile`.
  * 
- * @param   string      The string to tokenise on the first,
- *                      `NULL` on subsequent calls.
- *                      All bytes found in `delimiters` will
- *                      be overriden with NUL bytes.
- * @param   delimiters  Delimiting bytes (not characters).
- * @param   state       Pointer to a `char*` that the function
+ * @since  Always.
+ */
+struct memmem_needle;
+
+/**
+ * Prepare a substring for being searched for in many
+ * memory segments, so that this is done only once.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   needle         The sought after substring.
+ * @param   needle_length  The length of `needle`.
+ * @return                 The prepared substring, `NULL` on error. It
+ *                         shall be deallocated with `memmem_free`.
+ *                         It does not refer to `needle`.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+struct memmem_needle* memmem_compile(const void*, size_t)
+  __GCC_ONLY(__attribute__((__malloc__, __warn_unused_result__)));
+
+/**
+ * Find the first occurrence of a substring
+ * prepared with `memmem_compile`.
+ * This search is case sensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   compiled         The sought after substring.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @return                   Pointer to the first occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+void* memmem_exec(const struct memmem_needle*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__nonnull__(1), __warn_unused_result__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define memmem_exec(...)  (__const_correct2(memmem_exec, __VA_ARGS__))
+# endif
+
+/**
+ * Deallocate a substring prepared with `memmem_compile`.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  needle  The prepared substring, may be `NULL`.
+ * 
+ * @since  Always.
+ */
+void memmem_free(struct memmem_needle*);
+
+/**
+ * A set of needles compiled into an Aho–Corasick
+ * automaton, see `memmem_multi_compile`.
+ * 
+ * @since  Always.
+ */
+struct memmem_multi;
+
+/**
+ * Compile a set of needles, so that a haystack can be
+ * searched for all of them at once.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   needles  The needles.
+ * @param   lengths  The length of each needle, `NULL` if the
+ *                   needles are NUL-terminated strings.
+ * @param   count    The number of needles.
+ * @return           The compiled needles, `NULL` on error. It shall
+ *                   be deallocated with `memmem_multi_free`.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+struct memmem_multi* memmem_multi_compile(const void* const*, const size_t*, size_t)
+  __GCC_ONLY(__attribute__((__malloc__, __warn_unused_result__)));
+
+/**
+ * Find the first occurrence of any of a set of needles.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   automaton        The needles, compiled with `memmem_multi_compile`.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   which            Output parameter for the index of the found
+ *                           needle, may be `NULL`. If multiple needles
+ *                           occur at the returned position, the one with
+ *                           the lowest index is selected.
+ * @return                   The first position in `haystack` where any
+ *                           of the needles occur, `NULL` if none.
+ * 
+ * @since  Always.
+ */
+void* memmem_multi_exec(const struct memmem_multi*, const void*, size_t, size_t*)
+  __GCC_ONLY(__attribute__((__nonnull__(1), __warn_unused_result__)));
+# ifdef __CONST_CORRECT
+#  define memmem_multi_exec(...)  (__const_correct2(memmem_multi_exec, __VA_ARGS__))
+# endif
+
+/**
+ * Find every occurrence of each of a set of needles.
+ * Empty needles are ignored, and if two needles are
+ * identical, only the one with the lowest index is
+ * reported.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   automaton        The needles, compiled with `memmem_multi_compile`.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   callback         Function that is called for each occurrence,
+ *                           in the order they end, with the index of the
+ *                           needle, the offset of the occurrence in
+ *                           `haystack`, and `data`. If it returns non-zero,
+ *                           the search is stopped.
+ * @param   data             User-defined data for `callback`.
+ * @return                   The number of times `callback` was called.
+ * 
+ * @since  Always.
+ */
+size_t memmem_multi_each(const struct memmem_multi*, const void*, size_t,
+			 int (*)(size_t, size_t, void*), void*)
+  __GCC_ONLY(__attribute__((__nonnull__(1, 4))));
+
+/**
+ * Deallocate a set of needles compiled
+ * with `memmem_multi_compile`.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  automaton  The compiled needles, may be `NULL`.
+ * 
+ * @since  Always.
+ */
+void memmem_multi_free(struct memmem_multi*);
+
+/**
+ * Find the first occurrence of any of a set of needles.
+ * 
+ * When the same needles are used for many haystacks,
+ * use `memmem_multi_compile` and `memmem_multi_exec`.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   needles          The needles.
+ * @param   lengths          The length of each needle, `NULL` if the
+ *                           needles are NUL-terminated strings.
+ * @param   count            The number of needles.
+ * @param   which            Output parameter for the index of the found
+ *                           needle, may be `NULL`, see `memmem_multi_exec`.
+ * @return                   The first position in `haystack` where any
+ *                           of the needles occur, `NULL` if none or on
+ *                           error, in which case `errno` is set.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+void* memmem_multi(const void*, size_t, const void* const*, const size_t*, size_t, size_t*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__)));
+# ifdef __CONST_CORRECT
+#  define memmem_multi(...)  (__const_correct(memmem_multi, __VA_ARGS__))
+# endif
+
+/**
+ * Find the first occurrence of any of a set of substrings.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack  The string to search.
+ * @param   needles   `NULL`-terminated list of the sought after substrings.
+ * @param   which     Output parameter for the index of the found
+ *                    substring, may be `NULL`, see `memmem_multi_exec`.
+ * @return            The first position in `haystack` where any of
+ *                    the substrings occur, `NULL` if none or on
+ *                    error, in which case `errno` is set.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+char* strstr_any(const char*, const char* const*, size_t*)
+  __GCC_ONLY(__attribute__((__nonnull__(1, 2), __warn_unused_result__)));
+# ifdef __CONST_CORRECT
+#  define strstr_any(...)  (__const_correct(strstr_any, __VA_ARGS__))
+# endif
+
+/**
+ * Finds the first occurrence of a substring,
+ * using multiple threads for large haystacks.
+ * This search is case sensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @param   nthreads         The maximum number of threads to use,
+ *                           including the calling thread, 0 for
+ *                           one per online processor. slibc cannot
+ *                           create threads yet, so currently only
+ *                           the calling thread is used.
+ * @return                   Pointer to the first occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+void* memmem_mt(const void*, size_t, const void*, size_t, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__)));
+# ifdef __CONST_CORRECT
+#  define memmem_mt(...)  (__const_correct(memmem_mt, __VA_ARGS__))
+# endif
+
+/**
+ * Count the occurrences of a byte in a memory segment.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   c        The sought after byte.
+ * @param   size     The size of the memory segment.
+ * @return           The number of occurrences of `c`.
+ * 
+ * @since  Always.
+ */
+size_t memcount(const void*, int, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Count the lines in a memory segment. The last
+ * line is counted even if it is not terminated
+ * by a line feed, but it is not counted if it
+ * is empty.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The number of lines in `segment`.
+ * 
+ * @since  Always.
+ */
+size_t memcount_lines(const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Count the occurrences of a byte in a string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   str  The string.
+ * @param   c    The sought after byte.
+ * @return       The number of occurrences of `c`, the
+ *               terminating NUL byte is not counted.
+ * 
+ * @since  Always.
+ */
+size_t strcount(const char*, int)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Count the occurrences of a byte in a memory segment,
+ * using multiple threads for large memory segments.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment   The memory segment.
+ * @param   c         The sought after byte.
+ * @param   size      The size of the memory segment.
+ * @param   nthreads  The maximum number of threads to use,
+ *                    including the calling thread, 0 for
+ *                    one per online processor. slibc cannot
+ *                    create threads yet, so currently only
+ *                    the calling thread is used.
+ * @return            The number of occurrences of `c`.
+ * 
+ * @since  Always.
+ */
+size_t memcount_mt(const void*, int, size_t, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__)));
+
+/**
+ * Check whether a memory segment is valid UTF-8.
+ * 
+ * Overlong encodings, surrogates, characters above
+ * U+10FFFF, and characters that are cut off at the
+ * end of the segment are invalid.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           1 if `segment` is valid UTF-8, 0 otherwise.
+ * 
+ * @since  Always.
+ */
+int utf8_validate(const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Get the length of the longest prefix of a
+ * memory segment that is valid UTF-8. This is
+ * the position of the first invalid character,
+ * or of the character that is cut off at the
+ * end of the segment.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The length of the longest valid prefix,
+ *                   `size` iff `segment` is valid UTF-8.
+ * 
+ * @since  Always.
+ */
+size_t utf8_prefix_valid(const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Count the characters in a memory segment
+ * that contains UTF-8.
+ * 
+ * The segment is not validated, every byte that
+ * is not a continuation byte is counted.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The number of characters in `segment`.
+ * 
+ * @since  Always.
+ */
+size_t utf8_count(const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+#endif
+
+
+/**
+ * Returns length of the initial substring
+ * that consists entirely of a set of specified
+ * bytes.
+ * 
+ * @param   string   The string.
+ * @param   skipset  Bytes allowed in the substring.
+ * @return           The length of the substring.
+ * 
+ * @since  Always.
+ */
+size_t strspn(const char*, const char*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Returns length of the initial substring
+ * that consists entirely of the complement
+ * of a set of specified bytes.
+ * 
+ * @param   string   The string.
+ * @param   stopset  Bytes disallowed in the substring.
+ * @return           The length of the substring.
+ * 
+ * @since  Always.
+ */
+size_t strcspn(const char*, const char*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * This function works like `strcspn`,
+ * except it returns the pointer to the
+ * location of the first found non-matching
+ * byte.
+ * 
+ * @param   string   The string.
+ * @param   stopset  Bytes disallowed in the substring.
+ * @return           A pointer to the first occurrence in
+ *                   `string` of a byte found in `stopset`.
+ *                   `NULL` is returned if none is found.
+ * 
+ * @since  Always.
+ */
+char* strpbrk(const char*, const char*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+#ifdef __CONST_CORRECT
+# define strpbrk(...)  (__const_correct(strpbrk, __VA_ARGS__))
+#endif
+
+
+/**
+ * Tokenise a string.
+ * 
+ * @param   string      The string to tokenise on the first,
+ *                      `NULL` on subsequent calls.
+ *                      All bytes found in `delimiters` will
+ *                      be overriden with NUL bytes.
+ * @param   delimiters  Delimiting bytes (not characters).
+ * @return              The next non-empty string that does not
+ *                      contain a byte from `delimiters`. The
+ *                      returned string will be as long as possible.
+ *                      `NULL` is returned the search as reached
+ *                      the end of the string, and there therefore
+ *                      are no more tokens.
+ * 
+ * @since  Always.
+ */
+char* strtok(char* restrict, const char* restrict)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__(2))));
+
+/**
+ * Tokenise a string.
+ * 
+ * @param   string      The string to tokenise on the first,
+ *                      `NULL` on subsequent calls.
+ *                      All bytes found in `delimiters` will
+ *                      be overriden with NUL bytes.
+ * @param   delimiters  Delimiting bytes (not characters).
+ * @param   state       Pointer to a `char*` that the function
  *                      can use to keep track of its state.
  *                      It is reasonable to make it point to `NULL`
  *                      on the first call.
@@ -1360,6 +2063,107 @@ char* strtok_r(char* restrict, const char* restrict, char** restrict)
 char* strsep(char** restrict, const char* restrict)
   __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__)));
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * The state of `memsep` and `memtok`: a set of
+ * delimiters, prepared once with `memtok_init`,
+ * and the position in the memory segment.
+ * Only `position` may be used directly.
+ * 
+ * @since  Always.
+ */
+struct memtok_state
+{
+  /**
+   * The position in the memory segment where the
+   * next search begins. It is set to 0 by `memtok_init`,
+   * and may be set to 0 to search another memory
+   * segment with the same delimiters.
+   * 
+   * @since  Always.
+   */
+  size_t position;
+  
+  /**
+   * The prepared delimiters. This is private
+   * to slibc, its layout may change between
+   * versions, and it shall not be used.
+   * 
+   * @since  Always.
+   */
+  size_t __private[96 / sizeof(size_t)];
+};
+
+/**
+ * Prepare a set of delimiters for `memsep` and `memtok`,
+ * so that it is only done once for all fields.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state             The state to initialise.
+ * @param  delimiters        The bytes that separate fields,
+ *                           duplicates are allowed.
+ * @param  delimiters_size   The number of bytes in `delimiters`.
+ * 
+ * @since  Always.
+ */
+void memtok_init(struct memtok_state*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__nonnull__(1))));
+
+/**
+ * Find the next field in a memory segment, without
+ * modifying the memory segment. This is a variant of
+ * `strsep` for memory segments that are not terminated
+ * by a NUL byte and may be read-only.
+ * 
+ * Unlike `memtok`, empty fields are returned, and a
+ * memory segment of the size zero contains one field.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   state    The delimiters, prepared with `memtok_init`.
+ *                   Its `position` member is updated to the
+ *                   position after the returned field and
+ *                   its delimiter.
+ * @param   offset   Output parameter for the offset of the field.
+ * @param   length   Output parameter for the length of the field.
+ * @return           1 if a field was found, 0 if there
+ *                   are no more fields.
+ * 
+ * @since  Always.
+ */
+int memsep(const void*, size_t, struct memtok_state* restrict, size_t* restrict, size_t* restrict)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__(3, 4, 5))));
+
+/**
+ * Find the next token in a memory segment, without
+ * modifying the memory segment. This is a variant of
+ * `strtok_r` for memory segments that are not terminated
+ * by a NUL byte and may be read-only.
+ * 
+ * Unlike `memsep`, empty tokens are skipped.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   state    The delimiters, prepared with `memtok_init`.
+ *                   Its `position` member is updated to the
+ *                   position after the returned token and
+ *                   its delimiter.
+ * @param   offset   Output parameter for the offset of the token.
+ * @param   length   Output parameter for the length of the token.
+ * @return           1 if a token was found, 0 if there
+ *                   are no more tokens.
+ * 
+ * @since  Always.
+ */
+int memtok(const void*, size_t, struct memtok_state* restrict, size_t* restrict, size_t* restrict)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__(3, 4, 5))));
+#endif
+
 
 #if defined(__GNU_SOURCE) && !defined(basename)
 /**
@@ -1415,6 +2219,374 @@ char* memfrob(char*, size_t);
 #endif
 
 
+#if defined(__SLIBC_SOURCE)
+/**
+ * XOR a memory segment with another memory segment.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination memory segment, may be `src`
+ *                or `key`, but may not otherwise overlap with them.
+ * @param   src   The source memory segment.
+ * @param   key   The memory segment to XOR `src` with.
+ * @param   size  The size of the memory segments.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+void* memxor(void*, const void*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__returns_nonnull__, __nonnull__)));
+
+/**
+ * Copy a memory segment, but convert all
+ * ASCII letters to lowercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination memory segment, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source memory segment.
+ * @param   size  The size of the memory segments.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+void* memlower(void*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__returns_nonnull__, __nonnull__)));
+
+/**
+ * Copy a memory segment, but convert all
+ * ASCII letters to uppercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination memory segment, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source memory segment.
+ * @param   size  The size of the memory segments.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+void* memupper(void*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__returns_nonnull__, __nonnull__)));
+
+/**
+ * Copy a string, but convert all
+ * ASCII letters to lowercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination string, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source string.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+char* strlower(char*, const char*)
+  __GCC_ONLY(__attribute__((__returns_nonnull__, __nonnull__)));
+
+/**
+ * Copy a string, but convert all
+ * ASCII letters to uppercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination string, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source string.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+char* strupper(char*, const char*)
+  __GCC_ONLY(__attribute__((__returns_nonnull__, __nonnull__)));
+#endif
+
+
+#if defined(__SLIBC_SOURCE)
+/**
+ * The state of an incremental `memhash` computation.
+ * The members shall not be used directly.
+ * 
+ * @since  Always.
+ */
+struct memhash_state
+{
+  /**
+   * The accumulators.
+   * 
+   * @since  Always.
+   */
+  uint64_t v[4];
+  
+  /**
+   * The seed.
+   * 
+   * @since  Always.
+   */
+  uint64_t seed;
+  
+  /**
+   * The number of bytes hashed so far.
+   * 
+   * @since  Always.
+   */
+  uint64_t total;
+  
+  /**
+   * Bytes that do not yet make up a complete
+   * 32-byte stripe, `total % 32` of them.
+   * 
+   * @since  Always.
+   */
+  unsigned char buffer[32];
+};
+
+/**
+ * The state of an incremental `memsiphash` computation.
+ * The members shall not be used directly.
+ * 
+ * @since  Always.
+ */
+struct memsiphash_state
+{
+  /**
+   * The internal state.
+   * 
+   * @since  Always.
+   */
+  uint64_t v[4];
+  
+  /**
+   * The number of bytes hashed so far.
+   * 
+   * @since  Always.
+   */
+  uint64_t total;
+  
+  /**
+   * Bytes that do not yet make up a complete
+   * 8-byte word, `total % 8` of them.
+   * 
+   * @since  Always.
+   */
+  unsigned char buffer[8];
+};
+
+/**
+ * Calculate a fast, non-cryptographic, hash
+ * of a memory segment. The hash is XXH64.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   seed     Arbitrary value that selects the hash function.
+ * @return           The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t memhash(const void*, size_t, uint64_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Calculate a fast, non-cryptographic, hash of a
+ * string. This is `memhash` for the string without
+ * its terminating NUL byte.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   string  The string.
+ * @param   seed    Arbitrary value that selects the hash function.
+ * @return          The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t strhash(const char*, uint64_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Start an incremental `memhash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state  The state to initialise.
+ * @param  seed   Arbitrary value that selects the hash function.
+ * 
+ * @since  Always.
+ */
+void memhash_init(struct memhash_state*, uint64_t)
+  __GCC_ONLY(__attribute__((__nonnull__)));
+
+/**
+ * Add data to an incremental `memhash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state    The state.
+ * @param  segment  The data.
+ * @param  size     The size of the data.
+ * 
+ * @since  Always.
+ */
+void memhash_update(struct memhash_state*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__nonnull__(1))));
+
+/**
+ * Get the result of an incremental `memhash` computation.
+ * More data may be added to the computation afterwards.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   state  The state.
+ * @return         The hash of all data added so far.
+ * 
+ * @since  Always.
+ */
+uint64_t memhash_final(const struct memhash_state*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Calculate a keyed hash of a memory segment, that is
+ * resistant to collisions constructed without the key.
+ * The hash is SipHash-2-4.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   key      The 16-byte key, which should be secret and random.
+ * @return           The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t memsiphash(const void*, size_t, const void*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__(3), __pure__)));
+
+/**
+ * Calculate a keyed hash of a string. This is `memsiphash`
+ * for the string without its terminating NUL byte.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   string  The string.
+ * @param   key     The 16-byte key, which should be secret and random.
+ * @return          The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t strsiphash(const char*, const void*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Start an incremental `memsiphash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state  The state to initialise.
+ * @param  key    The 16-byte key, which should be secret and random.
+ * 
+ * @since  Always.
+ */
+void memsiphash_init(struct memsiphash_state*, const void*)
+  __GCC_ONLY(__attribute__((__nonnull__)));
+
+/**
+ * Add data to an incremental `memsiphash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state    The state.
+ * @param  segment  The data.
+ * @param  size     The size of the data.
+ * 
+ * @since  Always.
+ */
+void memsiphash_update(struct memsiphash_state*, const void*, size_t)
+  __GCC_ONLY(__attribute__((__nonnull__(1))));
+
+/**
+ * Get the result of an incremental `memsiphash` computation.
+ * More data may be added to the computation afterwards.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   state  The state.
+ * @return         The hash of all data added so far.
+ * 
+ * @since  Always.
+ */
+uint64_t memsiphash_final(const struct memsiphash_state*)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__, __pure__)));
+
+/**
+ * Calculate the CRC-32C (Castagnoli) checksum
+ * of a memory segment, or continue calculating it.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   crc      The checksum of the preceding data,
+ *                   0 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t crc32c(uint32_t, const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Calculate the CRC-32 (IEEE 802.3) checksum
+ * of a memory segment, or continue calculating it.
+ * This is the checksum used by zlib and gzip.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   crc      The checksum of the preceding data,
+ *                   0 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t crc32(uint32_t, const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+
+/**
+ * Calculate the Adler-32 checksum of a memory
+ * segment, or continue calculating it.
+ * This is the checksum used by zlib.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   adler    The checksum of the preceding data,
+ *                   1 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t adler32(uint32_t, const void*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+#endif
+
+
+
+
+/* With optimisation in GCC, `strcmp`, `strlen`, `memset`,
+ * `memcpy`, `strstarts` and `strends` are function-like
+ * macros. `#undef` them, or define `_SLIBC_NO_INLINE`,
+ * before declaring or defining them. */
+#if defined(__GNUC__) && defined(__OPTIMIZE__) && !defined(_SLIBC_NO_INLINE) && !defined(__BUILDING_SLIBC)
+# include <bits/string-inline.h>
+#endif
+
+
 
 #endif
 
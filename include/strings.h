@@ -73,7 +73,8 @@ void bcopy(const void*, void*, size_t)
   __deprecated("Use 'memmove', or similar function, instead, but be aware of reordered parameters.");
 
 /**
- * This function is identical to `memcmp`.
+ * This function is similar to `memcmp`, but only
+ * reports whether the segments differ, not how.
  * 
  * @etymology  (B)ytes: (c)o(mp)are.
  * 
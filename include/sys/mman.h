@@ -0,0 +1,225 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _SYS_MMAN_H
+#define _SYS_MMAN_H
+#include <slibc/version.h>
+#include <slibc/features.h>
+
+
+
+#define __NEED_size_t
+#define __NEED_off_t
+#include <bits/types.h>
+
+
+
+/**
+ * The pages may not be accessed.
+ * 
+ * @since  Always.
+ */
+#define PROT_NONE  0x0
+
+/**
+ * The pages may be read.
+ * 
+ * @since  Always.
+ */
+#define PROT_READ  0x1
+
+/**
+ * The pages may be written.
+ * 
+ * @since  Always.
+ */
+#define PROT_WRITE  0x2
+
+/**
+ * The pages may be executed.
+ * 
+ * @since  Always.
+ */
+#define PROT_EXEC  0x4
+
+
+/**
+ * Changes to the mapping are visible to other
+ * processes that map the same object, and are
+ * carried through to the underlying file.
+ * 
+ * @since  Always.
+ */
+#define MAP_SHARED  0x01
+
+/**
+ * Changes to the mapping are private to the
+ * process, they are not visible to other
+ * processes and are not carried through to
+ * the underlying file.
+ * 
+ * @since  Always.
+ */
+#define MAP_PRIVATE  0x02
+
+/**
+ * Place the mapping at exactly the requested
+ * address, replacing any mapping already there.
+ * 
+ * @since  Always.
+ */
+#define MAP_FIXED  0x10
+
+#if defined(__BSD_SOURCE) || defined(__GNU_SOURCE) || defined(__SLIBC_SOURCE)
+/**
+ * The mapping is not backed by a file; its pages
+ * are filled with zeroes. The file descriptor
+ * should be -1 and the offset shall be 0.
+ * 
+ * @since  Always.
+ */
+# define MAP_ANONYMOUS  0x20
+#endif
+
+
+/**
+ * Returned by `mmap` and `mremap` on error.
+ * 
+ * @since  Always.
+ */
+#define MAP_FAILED  ((void*)-1)
+
+
+#if defined(__GNU_SOURCE) || defined(__SLIBC_SOURCE)
+/**
+ * Allow `mremap` to move the mapping to
+ * a new address.
+ * 
+ * @since  Always.
+ */
+# define MREMAP_MAYMOVE  1
+
+/**
+ * Make `mremap` place the mapping at exactly the
+ * address specified in its fifth argument, replacing
+ * any mapping already there. Requires `MREMAP_MAYMOVE`.
+ * 
+ * @since  Always.
+ */
+# define MREMAP_FIXED  2
+
+/**
+ * Make `mremap` leave the old address range mapped
+ * when the mapping is moved. Requires `MREMAP_MAYMOVE`,
+ * and that the old and new sizes are equal. Older
+ * kernels only support this for private anonymous
+ * mappings, and some not at all.
+ * 
+ * @since  Always.
+ */
+# define MREMAP_DONTUNMAP  4
+
+
+/**
+ * The pages are not needed anymore, the kernel
+ * may free them lazily, unless they are written
+ * before that. Only supported for private
+ * anonymous mappings, `madvise` fails with
+ * `EINVAL` for other mappings.
+ * 
+ * @since  Always.
+ */
+# define MADV_FREE  8
+#endif
+
+
+
+/**
+ * Map files or devices into memory.
+ * 
+ * @param   addr    A hint for where to place the mapping,
+ *                  or the exact address if `MAP_FIXED`
+ *                  is used, `NULL` to let the kernel choose.
+ * @param   len     The length of the mapping.
+ * @param   prot    The allowed accesses, `PROT_NONE` or
+ *                  a combination of `PROT_READ`, `PROT_WRITE`,
+ *                  and `PROT_EXEC`.
+ * @param   flags   `MAP_SHARED` or `MAP_PRIVATE`, optionally
+ *                  combined with other `MAP_*` flags.
+ * @param   fd      The file to map, -1 for anonymous mappings.
+ * @param   offset  The offset into the file, a multiple
+ *                  of the pagesize.
+ * @return          The address of the mapping, `MAP_FAILED`
+ *                  on error.
+ * 
+ * @throws  Any error specified for mmap(2).
+ * 
+ * @since  Always.
+ */
+void* mmap(void*, size_t, int, int, int, off_t);
+
+/**
+ * Unmap pages from memory.
+ * 
+ * @param   addr  The beginning of the pages, page-aligned.
+ * @param   len   The number of bytes to unmap.
+ * @return        Zero on success, -1 on error.
+ * 
+ * @throws  Any error specified for munmap(2).
+ * 
+ * @since  Always.
+ */
+int munmap(void*, size_t);
+
+#if defined(__GNU_SOURCE) || defined(__SLIBC_SOURCE)
+/**
+ * Resize, and possibly move, a mapping.
+ * 
+ * @param   old_address  The beginning of the pages, page-aligned.
+ * @param   old_size     The number of bytes in the pages.
+ * @param   new_size     The new size.
+ * @param   flags        A combination of `MREMAP_*` flags.
+ * @param   ...          The new address, as a `void*`,
+ *                       if `MREMAP_FIXED` is used.
+ * @return               The new address of the pages,
+ *                       `MAP_FAILED` on error.
+ * 
+ * @throws  Any error specified for mremap(2).
+ * 
+ * @since  Always.
+ */
+void* mremap(void*, size_t, size_t, int, ...);
+
+/**
+ * Advise the kernel on how pages will be used.
+ * 
+ * @param   addr    The beginning of the pages, page-aligned.
+ * @param   len     The number of bytes.
+ * @param   advice  A `MADV_*` constant.
+ * @return          Zero on success, -1 on error.
+ * 
+ * @throws  Any error specified for madvise(2).
+ * 
+ * @since  Always.
+ */
+int madvise(void*, size_t, int);
+#endif
+
+
+
+#endif
+
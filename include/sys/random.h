@@ -0,0 +1,76 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _SYS_RANDOM_H
+#define _SYS_RANDOM_H
+#include <slibc/version.h>
+#include <slibc/features.h>
+
+
+
+#define __NEED_size_t
+#define __NEED_ssize_t
+#include <bits/types.h>
+
+
+
+#if defined(__GNU_SOURCE) || defined(__SLIBC_SOURCE)
+/**
+ * Make `getrandom` fail with `EAGAIN`, rather
+ * than block, if the entropy pool has not
+ * been initialised yet.
+ * 
+ * @since  Always.
+ */
+# define GRND_NONBLOCK  0x01
+
+/**
+ * Make `getrandom` read from the same source
+ * as /dev/random rather than /dev/urandom.
+ * 
+ * @since  Always.
+ */
+# define GRND_RANDOM  0x02
+
+
+
+/**
+ * Fill a buffer with random bytes, from the
+ * same source as /dev/urandom, unless
+ * `GRND_RANDOM` is used.
+ * 
+ * @param   buf     The buffer.
+ * @param   buflen  The size of the buffer.
+ * @param   flags   A combination of `GRND_*` flags.
+ * @return          The number of bytes written to `buf`,
+ *                  which may be less than `buflen`,
+ *                  -1 on error.
+ * 
+ * @throws  EAGAIN  `GRND_NONBLOCK` is used, and no
+ *                  random bytes were available.
+ * @throws  Any error specified for getrandom(2).
+ * 
+ * @since  Always.
+ */
+ssize_t getrandom(void*, size_t, unsigned int)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __nonnull__)));
+#endif
+
+
+
+#endif
+
@@ -138,6 +138,22 @@
 #define R_OK  4
 
 
+/**
+ * Used in `sysconf`, to get the size
+ * of a page, in bytes.
+ * 
+ * @since  Always.
+ */
+#define _SC_PAGESIZE  30
+
+/**
+ * Alias for `_SC_PAGESIZE`.
+ * 
+ * @since  Always.
+ */
+#define _SC_PAGE_SIZE  _SC_PAGESIZE
+
+
 
 /**
  * Set the high end of the calling process's
@@ -228,6 +244,21 @@ __noreturn void _exit(int);
 int isatty(int);
 
 
+/**
+ * Get the value of a configurable system variable.
+ * 
+ * @param   name  The variable, a `_SC_*` constant.
+ * @return        The value of the variable, -1 if it has
+ *                no limit or on error.
+ * 
+ * @throws  EINVAL  `name` is not a valid variable.
+ * 
+ * @since  Always.
+ */
+long sysconf(int)
+  __GCC_ONLY(__attribute__((__warn_unused_result__)));
+
+
 
 /**
  * Replace the current process image with a new process image.
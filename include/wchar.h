@@ -1219,7 +1219,28 @@ wchar_t* wmemmem(const wchar_t*, size_t, const wchar_t*, size_t)
 #endif
 
 
-/* TODO Add case right-to-left substring searching functions. */
+#if defined(__SLIBC_SOURCE)
+/**
+ * Finds the last occurrence of a substring.
+ * This search is case sensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @return                   Pointer to the last occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+wchar_t* wmemrmem(const wchar_t*, size_t, const wchar_t*, size_t)
+  __GCC_ONLY(__attribute__((__warn_unused_result__, __pure__)));
+# ifdef __CONST_CORRECT
+#  define wmemrmem(...)  (__const_correct(wmemrmem, __VA_ARGS__))
+# endif
+#endif
 
 
 /**
@@ -28,7 +28,6 @@
 #define PROT_WRITE 0
 #define MAP_PRIVATE 0
 #define MAP_ANONYMOUS 0
-#define _SC_PAGESIZE 0
 /* } */
 
 
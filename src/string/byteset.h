@@ -0,0 +1,424 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h"
+ * and "scan.h". It defines the kernels that search
+ * strings and memory segments for bytes in, or not in,
+ * a set of bytes, for the instruction set selected in
+ * "simd.h". Each kernel is named with `SIMD`, so the
+ * file may be included once per instruction set.
+ * 
+ * A set is prepared once per call with `byteset_init`,
+ * or `byteset_clear` and `byteset_add`, which record it
+ * as a 32-byte bitset, and, if it is small, as a list of
+ * its bytes. Small sets are matched a block at a time by
+ * comparing the block with each byte in the list. Larger
+ * sets are matched a block at a time if the instruction
+ * set can shuffle bytes: the low nibble of each byte
+ * selects, from one of two 16-byte tables depending on
+ * the highest bit of the byte, an 8-bit row of the
+ * bitset, and the rest of the high nibble selects the
+ * bit in that row. Otherwise, larger sets are matched a
+ * byte at a time with the bitset.
+ * 
+ * Blocks are loaded from aligned addresses, see "simd.h",
+ * because the end of the string is not known. */
+
+
+#ifndef BYTESET_H_COMMON
+#define BYTESET_H_COMMON
+
+
+/**
+ * The number of bytes that are listed in a `struct byteset`.
+ */
+#define BYTESET_LISTED  8
+
+
+/**
+ * A set of bytes, prepared for searching.
+ */
+struct byteset
+{
+  /**
+   * Bit `c % 8` in byte `c / 8` is set iff
+   * the byte `c` is in the set.
+   */
+  unsigned char bits[32];
+  
+  /**
+   * Bit `(c >> 4) & 7` in byte `c & 15` of
+   * `nibbles[c >> 7]` is set iff the byte
+   * `c` is in the set.
+   */
+  unsigned char nibbles[2][16];
+  
+  /**
+   * The bytes in the set, in the order they
+   * were first specified, if there are no
+   * more than `BYTESET_LISTED` of them.
+   */
+  unsigned char list[BYTESET_LISTED];
+  
+  /**
+   * The number of bytes in the set.
+   */
+  size_t size;
+};
+
+
+/**
+ * Check whether a byte is in a set.
+ * 
+ * @param   set  The set, as a `const struct byteset*`.
+ * @param   c    The byte, as a `char`.
+ * @return       Non-zero iff `c` is in `set`.
+ */
+#define BYTESET_HAS(set, c)  \
+  ((set)->bits[(unsigned char)(c) >> 3] & (1 << ((unsigned char)(c) & 7)))
+
+
+/**
+ * Make a set empty.
+ * 
+ * @param  set  The set.
+ */
+__attribute__((__unused__))
+static void
+byteset_clear(struct byteset* set)
+{
+  size_t i;
+  
+  for (i = 0; i < 32; i++)
+    set->bits[i] = 0, set->nibbles[i >> 4][i & 15] = 0;
+  set->size = 0;
+}
+
+
+/**
+ * Add a byte to a set.
+ * 
+ * @param  set  The set.
+ * @param  c    The byte, which may be NUL, but a set containing
+ *              NUL must not be used to search a string.
+ */
+__attribute__((__unused__))
+static void
+byteset_add(struct byteset* set, unsigned char c)
+{
+  if (BYTESET_HAS(set, c))
+    return;
+  set->bits[c >> 3] |= (unsigned char)(1 << (c & 7));
+  set->nibbles[c >> 7][c & 15] |= (unsigned char)(1 << ((c >> 4) & 7));
+  if (set->size < BYTESET_LISTED)
+    set->list[set->size] = c;
+  set->size++;
+}
+
+
+/**
+ * Prepare a set of bytes for searching.
+ * 
+ * @param  set    Output parameter for the set.
+ * @param  bytes  The bytes in the set, as a string,
+ *                duplicates are allowed.
+ */
+__attribute__((__unused__))
+static void
+byteset_init(struct byteset* restrict set, const char* restrict bytes)
+{
+  byteset_clear(set);
+  while (*bytes)
+    byteset_add(set, (unsigned char)*bytes++);
+}
+
+
+#endif
+
+
+
+/**
+ * The largest set that is matched by comparing
+ * a block with each of its bytes.
+ */
+#undef BYTESET_COMPARED
+#if SIMD_ISA == SIMD_SWAR
+# define BYTESET_COMPARED  2
+#elif defined(SIMD_SHUFFLE)
+# define BYTESET_COMPARED  3
+#else
+# define BYTESET_COMPARED  BYTESET_LISTED
+#endif
+
+
+/**
+ * Prepare the blocks that are used to match a set.
+ * 
+ * @param   set     The set.
+ * @param   blocks  Output parameter for the blocks.
+ * @return          Whether the set can be matched
+ *                  a block at a time.
+ */
+__attribute__((__unused__))
+static int
+SIMD(byteset_prepare)(const struct byteset* set, simd_t blocks[BYTESET_LISTED])
+{
+  size_t i;
+#ifdef SIMD_SHUFFLE
+  unsigned char tables[3][SIMD_WIDTH];
+  
+  if (set->size > BYTESET_COMPARED)
+    {
+      for (i = 0; i < SIMD_WIDTH; i++)
+	{
+	  tables[0][i] = set->nibbles[0][i & 15];
+	  tables[1][i] = set->nibbles[1][i & 15];
+	  tables[2][i] = (unsigned char)(1 << (i & 7));
+	}
+      for (i = 0; i < 3; i++)
+	blocks[i] = SIMD_LOADU(tables[i]);
+      return 1;
+    }
+#else
+  if (set->size > BYTESET_COMPARED)
+    return 0;
+#endif
+  
+  for (i = 0; i < set->size; i++)
+    blocks[i] = SIMD_SPLAT(set->list[i]);
+  return 1;
+}
+
+
+/**
+ * Get the mask of the bytes in a block that are in a set.
+ * 
+ * @param   v       The block.
+ * @param   set     The set.
+ * @param   blocks  The blocks prepared by `byteset_prepare`.
+ * @return          The mask of the bytes in `v` that are in `set`.
+ */
+__attribute__((__pure__, __unused__))
+static simd_mask_t
+SIMD(byteset_match)(simd_t v, const struct byteset* set, const simd_t blocks[BYTESET_LISTED])
+{
+  simd_mask_t m = 0;
+  size_t i;
+  
+#ifdef SIMD_SHUFFLE
+  simd_t row, bit;
+  if (set->size > BYTESET_COMPARED)
+    {
+      row  = SIMD_SHUFFLE(blocks[0], v & (char)0x8F);
+      row |= SIMD_SHUFFLE(blocks[1], (v & (char)0x8F) ^ (char)0x80);
+      bit  = SIMD_SHUFFLE(blocks[2], (v >> 4) & (char)0x0F);
+      return SIMD_ZERO(row & bit) ^ SIMD_ALL;
+    }
+#endif
+  
+  for (i = 0; i < set->size; i++)
+    m |= SIMD_EQ(v, blocks[i]);
+  return m;
+}
+
+
+/**
+ * Find the first byte in a string that is in,
+ * or is not in, a set of bytes.
+ * 
+ * @param   s           The string.
+ * @param   set         The set.
+ * @param   complement  Zero to find a byte in `set`,
+ *                      non-zero to find a byte not in `set`.
+ * @param   maxlen      The number of bytes to inspect, at most,
+ *                      `SIZE_MAX` for the entire string.
+ * @return              The first such byte, or the terminating NUL
+ *                      byte, or `s + maxlen`, whichever comes first.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(byteset_scan)(const char* s, const struct byteset* set, int complement, size_t maxlen)
+{
+  const char* block = SIMD_ALIGN(s);
+  size_t left = maxlen + (size_t)(s - block);
+  simd_t blocks[BYTESET_LISTED];
+  simd_mask_t m;
+  simd_t v;
+  size_t i;
+  int c1, c2;
+  
+  if (!complement && (set->size <= 2))
+    {
+      c1 = set->size > 0 ? set->list[0] : 0;
+      c2 = set->size > 1 ? set->list[1] : c1;
+      block = SIMD(scan_strnchrnul2)(s, c1, c2, maxlen);
+      return block ? block : s + maxlen;
+    }
+  
+  if (!SIMD(byteset_prepare)(set, blocks))
+    {
+      for (i = 0; (i < maxlen) && s[i]; i++)
+	if (!BYTESET_HAS(set, s[i]) == !!complement)
+	  break;
+      return s + i;
+    }
+  
+  if (!maxlen)
+    return s;
+  if (left < maxlen)
+    left = SIZE_MAX;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD(byteset_match)(v, set, blocks);
+  m = complement ? (m ^ SIMD_ALL) : (m | SIMD_ZERO(v));
+  m = SIMD_FROM(m, (size_t)(s - block));
+  while (!m)
+    {
+      if (left <= SIMD_WIDTH)
+	return block + left;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD(byteset_match)(v, set, blocks);
+      m = complement ? (m ^ SIMD_ALL) : (m | SIMD_ZERO(v));
+    }
+  return block + (SIMD_FIRST(m) < left ? SIMD_FIRST(m) : left);
+}
+
+
+/**
+ * Find the last byte in a string that is in,
+ * or is not in, a set of bytes.
+ * 
+ * @param   s           The string.
+ * @param   set         The set.
+ * @param   complement  Zero to find a byte in `set`,
+ *                      non-zero to find a byte not in `set`.
+ * @param   maxlen      The number of bytes to inspect, at most,
+ *                      `SIZE_MAX` for the entire string.
+ * @return              The last such byte before the terminating
+ *                      NUL byte and `s + maxlen`, `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(byteset_rscan)(const char* s, const struct byteset* set, int complement, size_t maxlen)
+{
+  const char* block = SIMD_ALIGN(s);
+  size_t left = maxlen + (size_t)(s - block);
+  simd_t blocks[BYTESET_LISTED];
+  const char* r = NULL;
+  simd_mask_t m, z;
+  simd_t v;
+  size_t i;
+  
+  if (!SIMD(byteset_prepare)(set, blocks))
+    {
+      for (i = 0; (i < maxlen) && s[i]; i++)
+	if (!BYTESET_HAS(set, s[i]) != !complement)
+	  r = s + i;
+      return r;
+    }
+  
+  if (!maxlen)
+    return NULL;
+  if (left < maxlen)
+    left = SIZE_MAX;
+  
+  for (;; left -= SIMD_WIDTH, block += SIMD_WIDTH)
+    {
+      v = SIMD_LOAD(block);
+      z = SIMD_ZERO(v);
+      m = SIMD(byteset_match)(v, set, blocks);
+      if (complement)
+	m ^= SIMD_ALL;
+      if (block < s)
+	{
+	  m = SIMD_FROM(m, (size_t)(s - block));
+	  z = SIMD_FROM(z, (size_t)(s - block));
+	}
+      if (z)
+	{
+	  i = SIMD_FIRST(z);
+	  if (i < left)
+	    left = i;
+	}
+      if (left < SIMD_WIDTH)
+	m = left ? SIMD_UPTO(m, left - 1) : 0;
+      if (m)
+	r = block + SIMD_LAST(m);
+      if (left <= SIMD_WIDTH)
+	return r;
+    }
+}
+
+
+
+/**
+ * Find the first byte in a memory segment that
+ * is in, or is not in, a set of bytes.
+ * 
+ * @param   s           The memory segment.
+ * @param   set         The set, which may contain NUL.
+ * @param   complement  Zero to find a byte in `set`,
+ *                      non-zero to find a byte not in `set`.
+ * @param   size        The size of the memory segment.
+ * @return              The first such byte, `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(byteset_memscan)(const char* s, const struct byteset* set, int complement, size_t size)
+{
+  const char* block = SIMD_ALIGN(s);
+  size_t left = size + (size_t)(s - block);
+  simd_t blocks[BYTESET_LISTED];
+  simd_mask_t m;
+  size_t i;
+  
+  if (!complement && (set->size <= 2))
+    {
+      if (!set->size)
+	return NULL;
+      return SIMD(scan_memchr2)(s, set->list[0], set->list[set->size - 1], size);
+    }
+  
+  if (!SIMD(byteset_prepare)(set, blocks))
+    {
+      for (i = 0; i < size; i++)
+	if (!BYTESET_HAS(set, s[i]) == !!complement)
+	  return s + i;
+      return NULL;
+    }
+  
+  if (!size)
+    return NULL;
+  if (left < size)
+    left = SIZE_MAX;
+  
+  m = SIMD(byteset_match)(SIMD_LOAD(block), set, blocks);
+  if (complement)
+    m ^= SIMD_ALL;
+  m = SIMD_FROM(m, (size_t)(s - block));
+  while (!m)
+    {
+      if (left <= SIMD_WIDTH)
+	return NULL;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      m = SIMD(byteset_match)(SIMD_LOAD(block), set, blocks);
+      if (complement)
+	m ^= SIMD_ALL;
+    }
+  return SIMD_FIRST(m) < left ? block + SIMD_FIRST(m) : NULL;
+}
@@ -0,0 +1,417 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h"
+ * and "hwcaps.h". It defines the kernels that
+ * compare memory segments and strings, for the instruction
+ * set selected in "simd.h". Each kernel is named with
+ * `SIMD`, so the file may be included once per
+ * instruction set.
+ * 
+ * The two operands of a comparison are rarely aligned
+ * to each other, so blocks are loaded unaligned. For
+ * memory segments, only blocks that are completely
+ * inside the segments are loaded, the end of a segment
+ * is compared with a block that overlaps the previous
+ * one. For strings, whose ends are unknown, a block is
+ * only loaded if it does not span two pages, otherwise
+ * it is compared a byte at a time.
+ * 
+ * Case-insensitive comparisons first compare the blocks
+ * as they are, and only fold them to lowercase if they
+ * differ, so equal text costs no more than with the
+ * case-sensitive kernels. This is not possible when
+ * only one of the operands is folded. The bytes that
+ * are returned are folded with `__slibc_fold`. */
+
+
+#ifndef COMPARE_H_COMMON
+#define COMPARE_H_COMMON
+
+
+
+/**
+ * Fold both operands of a case-insensitive
+ * comparison to lowercase.
+ */
+#define COMPARE_CASE  1
+
+/**
+ * Fold only the first operand of a case-insensitive
+ * comparison, to lowercase.
+ */
+#define COMPARE_LOWER  0
+
+/**
+ * Fold only the first operand of a case-insensitive
+ * comparison, to uppercase.
+ */
+#define COMPARE_UPPER  2
+
+
+/**
+ * Compare two bytes in a case-insensitive manner.
+ * 
+ * @param   a     One of the bytes.
+ * @param   b     The other byte.
+ * @param   fold  `COMPARE_CASE`, `COMPARE_LOWER`, or `COMPARE_UPPER`.
+ * @return        The difference between the bytes, after folding.
+ */
+__attribute__((__pure__, __unused__))
+static int
+compare_case(unsigned char a, unsigned char b, int fold)
+{
+  if (fold == COMPARE_UPPER)
+    return (int)a - ((unsigned char)(a - 'a') < 26 ? 0x20 : 0) - (int)b;
+  return (int)__slibc_fold[a] - (int)(fold == COMPARE_CASE ? __slibc_fold[b] : b);
+}
+
+
+/**
+ * Compare the beginning of two memory segments
+ * that are shorter than a block.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        The difference between the first
+ *                differing bytes, 0 if none.
+ */
+__attribute__((__pure__, __unused__))
+static int
+compare_short(const unsigned char* a, const unsigned char* b, size_t size)
+{
+  simd_word_t x;
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    {
+      x = *(const simd_uword_t*)(a + i) ^ *(const simd_uword_t*)(b + i);
+      if (x)
+	break;
+    }
+  for (; i < size; i++)
+    if (a[i] != b[i])
+      return (int)a[i] - (int)b[i];
+  return 0;
+}
+
+
+/**
+ * Check whether the beginning of two memory segments,
+ * that are shorter than a block, differ.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        0 if the segments are equal,
+ *                a non-zero value otherwise.
+ */
+__attribute__((__pure__, __unused__))
+static int
+compare_short_eq(const unsigned char* a, const unsigned char* b, size_t size)
+{
+  simd_word_t x = 0;
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    x |= *(const simd_uword_t*)(a + i) ^ *(const simd_uword_t*)(b + i);
+  for (; i < size; i++)
+    x |= (simd_word_t)(a[i] ^ b[i]);
+  return x != 0;
+}
+
+
+/**
+ * Compare the beginning of two memory segments, that are
+ * shorter than a block, in a case-insensitive manner.
+ * 
+ * @param   a       One of the memory segments.
+ * @param   b       The other memory segment.
+ * @param   size    The size of the segments.
+ * @param   fold    `COMPARE_CASE` to fold both operands to
+ *                  lowercase, `COMPARE_LOWER` to only fold `a`
+ *                  to lowercase, or `COMPARE_UPPER` to only
+ *                  fold `a` to uppercase.
+ * @return          The difference between the first differing
+ *                  bytes, after folding, 0 if none.
+ */
+__attribute__((__pure__, __unused__))
+static int
+compare_short_case(const unsigned char* a, const unsigned char* b, size_t size, int fold)
+{
+  size_t i = 0, end;
+  int d;
+  
+  while (i < size)
+    {
+      if ((fold == COMPARE_CASE) && (i + sizeof(simd_word_t) <= size) &&
+	  (*(const simd_uword_t*)(a + i) == *(const simd_uword_t*)(b + i)))
+	{
+	  i += sizeof(simd_word_t);
+	  continue;
+	}
+      end = i + sizeof(simd_word_t) <= size ? i + sizeof(simd_word_t) : size;
+      for (; i < end; i++)
+	if ((d = compare_case(a[i], b[i], fold)))
+	  return d;
+    }
+  return 0;
+}
+
+
+#endif
+
+
+
+/**
+ * Compare two memory segments.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        The difference between the first
+ *                differing bytes, 0 if none.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(compare_memcmp)(const unsigned char* a, const unsigned char* b, size_t size)
+{
+  simd_mask_t m;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    return compare_short(a, b, size);
+  
+  for (i = 0; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    {
+      m = SIMD_NE(SIMD_LOADU(a + i), SIMD_LOADU(b + i));
+      if (m)
+	goto found;
+    }
+  if (i == size)
+    return 0;
+  i = size - SIMD_WIDTH;
+  m = SIMD_NE(SIMD_LOADU(a + i), SIMD_LOADU(b + i));
+  if (!m)
+    return 0;
+  
+ found:
+  i += SIMD_FIRST(m);
+  return (int)a[i] - (int)b[i];
+}
+
+
+/**
+ * Check whether two memory segments differ.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        0 if the segments are equal,
+ *                a non-zero value otherwise.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(compare_bcmp)(const unsigned char* a, const unsigned char* b, size_t size)
+{
+  simd_mask_t m;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    return compare_short_eq(a, b, size);
+  
+  /* Only whether there is a difference is of interest,
+   * so two blocks are compared per check, and the
+   * position of the difference is never computed. */
+  for (i = 0; i + 2 * SIMD_WIDTH <= size; i += 2 * SIMD_WIDTH)
+    {
+      m  = SIMD_NE(SIMD_LOADU(a + i), SIMD_LOADU(b + i));
+      m |= SIMD_NE(SIMD_LOADU(a + i + SIMD_WIDTH), SIMD_LOADU(b + i + SIMD_WIDTH));
+      if (m)
+	return 1;
+    }
+  if (i + SIMD_WIDTH <= size)
+    {
+      if (SIMD_NE(SIMD_LOADU(a + i), SIMD_LOADU(b + i)))
+	return 1;
+      i += SIMD_WIDTH;
+    }
+  if (i == size)
+    return 0;
+  i = size - SIMD_WIDTH;
+  return SIMD_NE(SIMD_LOADU(a + i), SIMD_LOADU(b + i)) != 0;
+}
+
+
+/**
+ * Compare two strings, but only inspect
+ * the beginning of them.
+ * 
+ * @param   a       One of the strings.
+ * @param   b       The other string.
+ * @param   length  The number of bytes to inspect, at most,
+ *                  `SIZE_MAX` for the entire strings.
+ * @return          The difference between the first differing
+ *                  bytes, 0 if the strings are equal.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(compare_strncmp)(const unsigned char* a, const unsigned char* b, size_t length)
+{
+  simd_t v;
+  simd_mask_t m;
+  size_t i;
+  
+  while (length)
+    {
+      if (!SIMD_LOADU_SAFE(a) || !SIMD_LOADU_SAFE(b))
+	{
+	  /* Compare a block's worth of bytes, one at a
+	   * time, so that no load spans two pages. */
+	  for (i = 0; i < SIMD_WIDTH && i < length; i++)
+	    if ((a[i] != b[i]) || !a[i])
+	      return (int)a[i] - (int)b[i];
+	}
+      else
+	{
+	  v = SIMD_LOADU(a);
+	  m = SIMD_NE(v, SIMD_LOADU(b)) | SIMD_ZERO(v);
+	  if (length < SIMD_WIDTH)
+	    m = SIMD_UPTO(m, length - 1);
+	  if (m)
+	    {
+	      i = SIMD_FIRST(m);
+	      return (int)a[i] - (int)b[i];
+	    }
+	}
+      if (length <= SIMD_WIDTH)
+	break;
+      length -= SIMD_WIDTH, a += SIMD_WIDTH, b += SIMD_WIDTH;
+    }
+  return 0;
+}
+
+
+/**
+ * Compare two memory segments in a
+ * case-insensitive manner.
+ * 
+ * @param   a       One of the memory segments.
+ * @param   b       The other memory segment.
+ * @param   size    The size of the segments.
+ * @param   fold    `COMPARE_CASE` to fold both operands to
+ *                  lowercase, `COMPARE_LOWER` to only fold `a`
+ *                  to lowercase, or `COMPARE_UPPER` to only
+ *                  fold `a` to uppercase.
+ * @return          The difference between the first differing
+ *                  bytes, after folding, 0 if none.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(compare_memcasecmp)(const unsigned char* a, const unsigned char* b, size_t size, int fold)
+{
+  simd_t va, vb;
+  simd_mask_t m;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    return compare_short_case(a, b, size, fold);
+  
+  for (i = 0;; i += SIMD_WIDTH)
+    {
+      if (i + SIMD_WIDTH > size)
+	{
+	  if (i == size)
+	    return 0;
+	  i = size - SIMD_WIDTH;
+	}
+      va = SIMD_LOADU(a + i);
+      vb = SIMD_LOADU(b + i);
+      if (fold == COMPARE_CASE)
+	{
+	  if (!SIMD_NE(va, vb))
+	    continue;
+	  vb = SIMD_LOWER(vb);
+	}
+      m = SIMD_NE(fold == COMPARE_UPPER ? SIMD_UPPER(va) : SIMD_LOWER(va), vb);
+      if (m)
+	{
+	  i += SIMD_FIRST(m);
+	  return compare_case(a[i], b[i], fold);
+	}
+    }
+}
+
+
+/**
+ * Compare two strings in a case-insensitive manner,
+ * but only inspect the beginning of them.
+ * 
+ * @param   a       One of the strings.
+ * @param   b       The other string.
+ * @param   length  The number of bytes to inspect, at most,
+ *                  `SIZE_MAX` for the entire strings.
+ * @param   fold    `COMPARE_CASE` to fold both operands to
+ *                  lowercase, `COMPARE_LOWER` to only fold `a`
+ *                  to lowercase, or `COMPARE_UPPER` to only
+ *                  fold `a` to uppercase.
+ * @return          The difference between the first differing
+ *                  bytes, after folding, 0 if the strings are equal.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(compare_strncasecmp)(const unsigned char* a, const unsigned char* b, size_t length, int fold)
+{
+  simd_t va, vb;
+  simd_mask_t m;
+  size_t i;
+  int d;
+  
+  while (length)
+    {
+      if (!SIMD_LOADU_SAFE(a) || !SIMD_LOADU_SAFE(b))
+	{
+	  for (i = 0; i < SIMD_WIDTH && i < length; i++)
+	    if ((d = compare_case(a[i], b[i], fold)) || !a[i])
+	      return d;
+	}
+      else
+	{
+	  va = SIMD_LOADU(a);
+	  vb = SIMD_LOADU(b);
+	  if ((fold != COMPARE_CASE) || SIMD_NE(va, vb) || SIMD_ZERO(va))
+	    {
+	      if (fold == COMPARE_CASE)
+		vb = SIMD_LOWER(vb);
+	      m = SIMD_NE(fold == COMPARE_UPPER ? SIMD_UPPER(va) : SIMD_LOWER(va), vb) | SIMD_ZERO(va);
+	      if (length < SIMD_WIDTH)
+		m = SIMD_UPTO(m, length - 1);
+	      if (m)
+		{
+		  i = SIMD_FIRST(m);
+		  return compare_case(a[i], b[i], fold);
+		}
+	    }
+	}
+      if (length <= SIMD_WIDTH)
+	break;
+      length -= SIMD_WIDTH, a += SIMD_WIDTH, b += SIMD_WIDTH;
+    }
+  return 0;
+}
+
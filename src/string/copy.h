@@ -0,0 +1,543 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h".
+ * It defines the kernels that copy and fill memory
+ * segments, for the instruction set selected in
+ * "simd.h". Each kernel is named with `SIMD`, so the
+ * file may be included once per instruction set.
+ * 
+ * Blocks are stored at addresses aligned to their
+ * width, and loaded from wherever the source happens
+ * to be. The unaligned beginning and end of the
+ * destination are written with one unaligned block
+ * each, overlapping the aligned blocks. Both of these
+ * blocks are loaded before anything is stored, so
+ * the same code is correct for overlapping segments
+ * as long as the aligned blocks are copied in the
+ * right direction.
+ * 
+ * Fills with a pattern, rather than a single byte,
+ * store the same block at every aligned address, as
+ * long as the pattern is no wider than the block. It
+ * is only the phase of the pattern that depends on the
+ * alignment of the destination.
+ * 
+ * The kernels that copy until a specific byte store
+ * the same blocks that they search, so the source is
+ * only read once. They copy forwards with unaligned
+ * stores, so the destination may overlap with the
+ * source if it is not after it. */
+
+
+#ifndef COPY_H_COMMON
+#define COPY_H_COMMON
+
+
+/**
+ * Copy a memory segment, from its beginning to its end,
+ * a word at a time. The segments may overlap if the
+ * destination is before the source.
+ * 
+ * @param  d     The destination.
+ * @param  s     The source.
+ * @param  size  The number of bytes to copy.
+ */
+__attribute__((__unused__))
+static void
+copy_forward(char* d, const char* s, size_t size)
+{
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    *(simd_uword_t*)(d + i) = *(const simd_uword_t*)(s + i);
+  for (; i < size; i++)
+    d[i] = s[i];
+}
+
+
+/**
+ * Copy a memory segment, from its end to its beginning,
+ * a word at a time. The segments may overlap if the
+ * destination is after the source.
+ * 
+ * @param  d     The destination.
+ * @param  s     The source.
+ * @param  size  The number of bytes to copy.
+ */
+__attribute__((__unused__))
+static void
+copy_backward(char* d, const char* s, size_t size)
+{
+  while (size >= sizeof(simd_word_t))
+    {
+      size -= sizeof(simd_word_t);
+      *(simd_uword_t*)(d + size) = *(const simd_uword_t*)(s + size);
+    }
+  while (size--)
+    d[size] = s[size];
+}
+
+
+/**
+ * Fill a memory segment a word at a time.
+ * 
+ * @param  d     The memory segment.
+ * @param  c     The byte to fill the segment with.
+ * @param  size  The size of the segment.
+ */
+__attribute__((__unused__))
+static void
+copy_fill(char* d, int c, size_t size)
+{
+  simd_word_t w = (simd_word_t)(unsigned char)c * SIMD_ONES;
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    *(simd_uword_t*)(d + i) = w;
+  for (; i < size; i++)
+    d[i] = (char)c;
+}
+
+
+/**
+ * Swap the contents of two non-overlapping
+ * memory segments, a word at a time.
+ * 
+ * @param  a     One of the memory segments.
+ * @param  b     The other memory segment.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+copy_swap(char* restrict a, char* restrict b, size_t size)
+{
+  simd_word_t t;
+  size_t i = 0;
+  char c;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    {
+      t = *(simd_uword_t*)(a + i);
+      *(simd_uword_t*)(a + i) = *(simd_uword_t*)(b + i);
+      *(simd_uword_t*)(b + i) = t;
+    }
+  for (; i < size; i++)
+    c = a[i], a[i] = b[i], b[i] = c;
+}
+
+
+/**
+ * Reverse the order of the elements in an array,
+ * an element at a time.
+ * 
+ * @param  p      The array.
+ * @param  count  The number of elements.
+ * @param  width  The size of each element.
+ */
+__attribute__((__unused__))
+static void
+copy_reverse(char* p, size_t count, size_t width)
+{
+  char* q;
+  
+  if (!count)
+    return;
+  q = p + (count - 1) * width;
+  for (; p < q; p += width, q -= width)
+    copy_swap(p, q, width);
+}
+
+
+/**
+ * Reverse the order of the `w`-byte elements in the
+ * first and last `SIMD_WIDTH` bytes of `p[lo]` through
+ * `p[hi - 1]`, and swap them, until less than two
+ * blocks are left.
+ * 
+ * @param  p   The array.
+ * @param  lo  The beginning of the part that is left, in bytes.
+ * @param  hi  The end of the part that is left, in bytes.
+ * @param  w   The size of each element, a constant.
+ */
+#define COPY_REVERSE_BLOCKS(p, lo, hi, w)				\
+  do									\
+    {									\
+      simd_t copy_a_, copy_b_;							\
+      for (; (lo) + 2 * SIMD_WIDTH <= (hi); (lo) += SIMD_WIDTH, (hi) -= SIMD_WIDTH)	\
+	{								\
+	  copy_a_ = SIMD_LOADU((p) + (lo));					\
+	  copy_b_ = SIMD_LOADU((p) + (hi) - SIMD_WIDTH);			\
+	  SIMD_STOREU((p) + (lo), SIMD_REVERSE(copy_b_, w));		\
+	  SIMD_STOREU((p) + (hi) - SIMD_WIDTH, SIMD_REVERSE(copy_a_, w));	\
+	}								\
+    }									\
+  while (0)
+
+
+/**
+ * The size of the buffer that `copy_pattern` fills,
+ * two of the widest blocks.
+ */
+#define COPY_PATTERN_SIZE  128
+
+
+/**
+ * Repeat a pattern, whose size is a power of two,
+ * and at most 8, to fill `COPY_PATTERN_SIZE` bytes,
+ * as required by `copy_memset_pattern`.
+ * 
+ * @param  block    Output buffer of `COPY_PATTERN_SIZE` bytes.
+ * @param  pattern  The pattern.
+ * @param  size     The size of the pattern.
+ */
+__attribute__((__unused__))
+static void
+copy_pattern(char* restrict block, const char* restrict pattern, size_t size)
+{
+  size_t i;
+  for (i = 0; i < COPY_PATTERN_SIZE; i++)
+    block[i] = pattern[i & (size - 1)];
+}
+
+
+#endif
+
+
+
+/**
+ * Copy a memory segment, that does not overlap
+ * with the destination.
+ * 
+ * @param  d     The destination.
+ * @param  s     The source.
+ * @param  size  The number of bytes to copy.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memcpy)(char* restrict d, const char* restrict s, size_t size)
+{
+  simd_t head, tail;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      copy_forward(d, s, size);
+      return;
+    }
+  
+  head = SIMD_LOADU(s);
+  tail = SIMD_LOADU(s + size - SIMD_WIDTH);
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    SIMD_STORE(d + i, SIMD_LOADU(s + i));
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
+
+/**
+ * Copy a memory segment, that may overlap
+ * with the destination.
+ * 
+ * @param  d     The destination.
+ * @param  s     The source.
+ * @param  size  The number of bytes to copy.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memmove)(char* d, const char* s, size_t size)
+{
+  simd_t head, tail;
+  size_t i;
+  
+  if ((d == s) || !size)
+    return;
+  
+  if (size < SIMD_WIDTH)
+    {
+      if (d < s)
+	copy_forward(d, s, size);
+      else
+	copy_backward(d, s, size);
+      return;
+    }
+  
+  head = SIMD_LOADU(s);
+  tail = SIMD_LOADU(s + size - SIMD_WIDTH);
+  if ((size_t)(d - s) >= size)
+    {
+      /* The destination is before the source, or the
+       * segments do not overlap: copy forwards. */
+      for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+	SIMD_STORE(d + i, SIMD_LOADU(s + i));
+    }
+  else
+    {
+      /* The destination starts inside the
+       * source: copy backwards. */
+      for (i = size - ((size_t)(d + size) & (SIMD_WIDTH - 1)); i >= SIMD_WIDTH;)
+	{
+	  i -= SIMD_WIDTH;
+	  SIMD_STORE(d + i, SIMD_LOADU(s + i));
+	}
+    }
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
+
+/**
+ * Fill a memory segment with a byte.
+ * 
+ * @param  d     The memory segment.
+ * @param  c     The byte to fill the segment with.
+ * @param  size  The size of the segment.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memset)(char* d, int c, size_t size)
+{
+  simd_t v;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      copy_fill(d, c, size);
+      return;
+    }
+  
+  v = SIMD_SPLAT(c);
+  SIMD_STOREU(d, v);
+  SIMD_STOREU(d + size - SIMD_WIDTH, v);
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    SIMD_STORE(d + i, v);
+}
+
+
+/**
+ * Fill a memory segment with a repeated pattern.
+ * 
+ * Unless the pattern is wider than a block, its size
+ * divides the width of a block, so all aligned blocks
+ * are the same, but rotated
+ * by the position of the first aligned block modulo
+ * the size of the pattern. The rotated block is loaded
+ * from the repeated pattern at that offset.
+ * 
+ * @param  d        The memory segment.
+ * @param  pattern  The pattern, repeated to fill `COPY_PATTERN_SIZE`
+ *                  bytes, see `copy_pattern`.
+ * @param  period   The size of the pattern, a power of two,
+ *                  at most 8.
+ * @param  size     The size of the segment, the last
+ *                  repetition is truncated if it does
+ *                  not fit.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memset_pattern)(char* d, const char* pattern, size_t period, size_t size)
+{
+  simd_t v;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      copy_forward(d, pattern, size);
+      return;
+    }
+  
+  SIMD_STOREU(d, SIMD_LOADU(pattern));
+  SIMD_STOREU(d + size - SIMD_WIDTH, SIMD_LOADU(pattern + ((size - SIMD_WIDTH) & (period - 1))));
+  i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1));
+  if (period > SIMD_WIDTH)
+    {
+      /* Only with words narrower than the pattern. */
+      for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+	SIMD_STORE(d + i, SIMD_LOADU(pattern + (i & (period - 1))));
+      return;
+    }
+  v = SIMD_LOADU(pattern + (i & (period - 1)));
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    SIMD_STORE(d + i, v);
+}
+
+
+/**
+ * Swap the contents of two non-overlapping memory segments.
+ * 
+ * @param  a     One of the memory segments.
+ * @param  b     The other memory segment.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memswap)(char* restrict a, char* restrict b, size_t size)
+{
+  simd_t va, vb;
+  size_t i;
+  
+  for (i = 0; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    {
+      va = SIMD_LOADU(a + i);
+      vb = SIMD_LOADU(b + i);
+      SIMD_STOREU(a + i, vb);
+      SIMD_STOREU(b + i, va);
+    }
+  copy_swap(a + i, b + i, size - i);
+}
+
+
+/**
+ * Reverse the order of the elements in an array.
+ * 
+ * Blocks are taken from both ends, reversed, and stored
+ * at the opposite ends. The middle, which is less than
+ * two blocks, is reversed an element at a time.
+ * 
+ * @param  p      The array.
+ * @param  count  The number of elements.
+ * @param  width  The size of each element, 1, 2, 4 or 8.
+ */
+__attribute__((__unused__))
+static void
+SIMD(copy_memrev)(char* p, size_t count, size_t width)
+{
+  size_t lo = 0, hi = count * width;
+  
+  if (width <= SIMD_WIDTH)
+    switch (width)
+      {
+      case 1:  COPY_REVERSE_BLOCKS(p, lo, hi, 1);  break;
+      case 2:  COPY_REVERSE_BLOCKS(p, lo, hi, 2);  break;
+      case 4:  COPY_REVERSE_BLOCKS(p, lo, hi, 4);  break;
+      default: COPY_REVERSE_BLOCKS(p, lo, hi, 8);  break;
+      }
+  copy_reverse(p + lo, (hi - lo) / width, width);
+}
+
+
+/**
+ * Copy a memory segment, but stop before the
+ * first occurrence of a specific byte.
+ * 
+ * @param   d     The destination, may overlap with `s`
+ *                only if it is not after `s`.
+ * @param   s     The source.
+ * @param   c     The byte to stop at.
+ * @param   size  The size of the source.
+ * @return        The first occurrence of `c` in `s`,
+ *                `NULL` if none; in which case all
+ *                of `s` was copied.
+ */
+__attribute__((__unused__))
+static const char*
+SIMD(copy_memccpy)(char* d, const char* s, int c, size_t size)
+{
+  const simd_t needle = SIMD_SPLAT(c);
+  simd_t v;
+  simd_mask_t m;
+  size_t i, n;
+  
+  for (i = 0; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    {
+      v = SIMD_LOADU(s + i);
+      m = SIMD_EQ(v, needle);
+      if (m)
+	{
+	  n = SIMD_FIRST(m);
+	  copy_forward(d + i, s + i, n);
+	  return s + i + n;
+	}
+      SIMD_STOREU(d + i, v);
+    }
+  
+  /* Less than a block remains, it is searched with
+   * a block that extends past the end of the segment,
+   * unless that block spans two pages. */
+  n = size - i;
+  if (n && SIMD_LOADU_SAFE(s + i))
+    {
+      m = SIMD_UPTO(SIMD_EQ(SIMD_LOADU(s + i), needle), n - 1);
+      if (m)
+	n = SIMD_FIRST(m);
+      copy_forward(d + i, s + i, n);
+      return m ? s + i + n : NULL;
+    }
+  for (; i < size; i++)
+    {
+      if (s[i] == (char)c)
+	return s + i;
+      d[i] = s[i];
+    }
+  return NULL;
+}
+
+
+/**
+ * Copy a string, but stop before its terminating
+ * NUL byte or before the first occurrence of a
+ * specific byte, whichever comes first.
+ * 
+ * @param   d       The destination, may overlap with `s`
+ *                  only if it is not after `s`.
+ * @param   s       The source.
+ * @param   c       The byte to stop at.
+ * @param   maxlen  The maximum number of bytes to copy,
+ *                  `SIZE_MAX` for no limit.
+ * @return          The first occurrence of `c` or NUL in `s`,
+ *                  `s + maxlen` if neither occurs in the first
+ *                  `maxlen` bytes. The bytes before it were copied.
+ */
+__attribute__((__unused__))
+static const char*
+SIMD(copy_strccpy)(char* d, const char* s, int c, size_t maxlen)
+{
+  const simd_t needle = SIMD_SPLAT(c);
+  simd_t v;
+  simd_mask_t m;
+  size_t i = 0, n;
+  
+  while (i < maxlen)
+    {
+      if (!SIMD_LOADU_SAFE(s + i))
+	{
+	  /* Copy a block's worth of bytes, one at a
+	   * time, so that no load spans two pages. */
+	  for (n = i + SIMD_WIDTH; (i < n) && (i < maxlen); i++)
+	    {
+	      if ((s[i] == (char)c) || !s[i])
+		return s + i;
+	      d[i] = s[i];
+	    }
+	  continue;
+	}
+      v = SIMD_LOADU(s + i);
+      m = SIMD_EQ(v, needle) | SIMD_ZERO(v);
+      if (maxlen - i < SIMD_WIDTH)
+	m = SIMD_UPTO(m, maxlen - i - 1);
+      if (m || (maxlen - i <= SIMD_WIDTH))
+	{
+	  n = m ? SIMD_FIRST(m) : maxlen - i;
+	  copy_forward(d + i, s + i, n);
+	  return s + i + n;
+	}
+      SIMD_STOREU(d + i, v);
+      i += SIMD_WIDTH;
+    }
+  return s + maxlen;
+}
+
@@ -0,0 +1,150 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included by functions that
+ * use the kernels in "scan.h", "compare.h", "copy.h",
+ * "substr.h", "byteset.h", "transform.h", and "utf8.h".
+ * It compiles the kernels once for each instruction set
+ * that the library supports on the target architecture,
+ * using the GCC target pragma so that the library itself
+ * need not be compiled for anything newer than the
+ * architecture's baseline, and defines `DISPATCH`, which
+ * selects the best compiled version for the running CPU.
+ * 
+ * The selection is made on the first call, and stored in
+ * a function pointer, which subsequent calls use directly.
+ * IFUNC relocations are not used, as they require the
+ * dynamic linker and startup code to cooperate, which
+ * slibc does not provide, and IFUNC resolvers run before
+ * the environment is accessible, so SLIBC_HWCAPS could
+ * not be honoured. */
+
+
+#include "hwcaps.h"
+#include <stddef.h>
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+# undef SIMD_ISA
+# define SIMD_ISA  SIMD_SWAR
+# include "simd.h"
+# include "scan.h"
+# include "compare.h"
+# include "copy.h"
+# include "substr.h"
+# include "byteset.h"
+# include "transform.h"
+# include "utf8.h"
+
+# pragma GCC push_options
+# pragma GCC target("sse2")
+# undef SIMD_ISA
+# define SIMD_ISA  SIMD_SSE2
+# include "simd.h"
+# include "scan.h"
+# include "compare.h"
+# include "copy.h"
+# include "substr.h"
+# include "byteset.h"
+# include "transform.h"
+# include "utf8.h"
+# pragma GCC pop_options
+
+# pragma GCC push_options
+# pragma GCC target("avx2")
+# undef SIMD_ISA
+# define SIMD_ISA  SIMD_AVX2
+# include "simd.h"
+# include "scan.h"
+# include "compare.h"
+# include "copy.h"
+# include "substr.h"
+# include "byteset.h"
+# include "transform.h"
+# include "utf8.h"
+# pragma GCC pop_options
+
+# pragma GCC push_options
+# pragma GCC target("avx512f,avx512bw")
+# undef SIMD_ISA
+# define SIMD_ISA  SIMD_AVX512
+# include "simd.h"
+# include "scan.h"
+# include "compare.h"
+# include "copy.h"
+# include "substr.h"
+# include "byteset.h"
+# include "transform.h"
+# include "utf8.h"
+# pragma GCC pop_options
+
+/**
+ * Select the best version of a kernel for the running CPU.
+ * 
+ * @param   kernel  The name of the kernel, without the
+ *                  instruction set suffix.
+ * @return          Pointer to the selected version.
+ */
+# define DISPATCH_SELECT(kernel)					\
+  ((__slibc_hwcaps() & HWCAP_AVX512BW) ? kernel##_avx512 :		\
+   (__slibc_hwcaps() & HWCAP_AVX2)     ? kernel##_avx2   :		\
+   (__slibc_hwcaps() & HWCAP_SSE2)     ? kernel##_sse2   :		\
+					 kernel##_swar)
+
+/**
+ * Get the version of a kernel that shall be used.
+ * 
+ * The version is selected when the expansion is first
+ * evaluated, and remembered in a function pointer that
+ * is private to the expansion, so each function should
+ * only expand this macro once per kernel.
+ * 
+ * @param   kernel  The name of the kernel, without the
+ *                  instruction set suffix.
+ * @return          The kernel, it can be called directly.
+ */
+# define DISPATCH(kernel)						\
+  (*({									\
+      static __typeof__(&kernel##_swar) dispatch_impl_ = NULL;	\
+      __typeof__(&kernel##_swar) dispatch_f_;				\
+      dispatch_f_ = __atomic_load_n(&dispatch_impl_, __ATOMIC_RELAXED);	\
+      if (__builtin_expect(!dispatch_f_, 0))				\
+	{								\
+	  dispatch_f_ = DISPATCH_SELECT(kernel);			\
+	  __atomic_store_n(&dispatch_impl_, dispatch_f_, __ATOMIC_RELAXED); \
+	}								\
+      dispatch_f_;							\
+    }))
+
+#else
+
+# undef SIMD_ISA
+# define SIMD_ISA  SIMD_SWAR
+# include "simd.h"
+# include "scan.h"
+# include "compare.h"
+# include "copy.h"
+# include "substr.h"
+# include "byteset.h"
+# include "transform.h"
+# include "utf8.h"
+
+# define DISPATCH(kernel)  kernel##_swar
+
+#endif
+
@@ -0,0 +1,79 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdint.h>
+
+
+
+/**
+ * The modulo of the Adler-32 sums.
+ */
+#define BASE  65521U
+
+/**
+ * The number of bytes that can be added to the sums
+ * before they must be reduced, without overflowing.
+ */
+#define NMAX  5552
+
+
+
+/**
+ * Calculate the Adler-32 checksum of a memory
+ * segment, or continue calculating it.
+ * This is the checksum used by zlib.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   adler    The checksum of the preceding data,
+ *                   1 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t adler32(uint32_t adler, const void* segment, size_t size)
+{
+  const unsigned char* s = segment;
+  uint32_t a = adler & 0xFFFF, b = adler >> 16;
+  size_t n, i;
+  
+  /* The sums are only reduced once every `NMAX`
+   * bytes, and the inner loop is unrolled so that
+   * the additions to `b` of eight bytes can be
+   * executed in parallel. */
+  while (size)
+    {
+      n = size < NMAX ? size : NMAX;
+      size -= n;
+      for (i = 0; i + 8 <= n; i += 8, s += 8)
+	{
+	  b += 8 * a + 8U * s[0] + 7U * s[1] + 6U * s[2] + 5U * s[3]
+		     + 4U * s[4] + 3U * s[5] + 2U * s[6] + 1U * s[7];
+	  a += (uint32_t)s[0] + s[1] + s[2] + s[3] + s[4] + s[5] + s[6] + s[7];
+	}
+      for (; i < n; i++, s++)
+	b += a += *s;
+      a %= BASE;
+      b %= BASE;
+    }
+  
+  return (b << 16) | a;
+}
+
@@ -0,0 +1,349 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the kernels for the CRC functions.
+ * They operate on the CRC register, that is, the CRC
+ * before it is inverted, and all polynomials are
+ * reflected, so bit 31 is the coefficient of x⁰.
+ * 
+ * Without any instruction set extension, the CRC is
+ * computed eight bytes at a time with the tables in
+ * "crctable.c". On x86, CRC-32C is computed with the
+ * CRC32 instruction of SSE4.2. Long segments are split
+ * into three parts whose CRCs are computed interleaved,
+ * as the instruction has a latency of three cycles but
+ * can be started every cycle, and then combined by
+ * multiplication by xⁿ modulo the polynomial. CRC-32
+ * is computed by folding 64 bytes at a time with
+ * carry-less multiplication, if PCLMULQDQ is available.
+ * 
+ * The kernels that use instruction set extensions are
+ * compiled with the GCC target pragma, see "dispatch.h",
+ * and selected with `__slibc_hwcaps`. */
+
+
+#ifndef CRC_H
+#define CRC_H
+
+
+#include "../hwcaps.h"
+#include <stdint.h>
+#include <stddef.h>
+
+
+
+/**
+ * The reflected CRC-32C (Castagnoli) polynomial.
+ */
+#define CRC32C_POLY  UINT32_C(0x82F63B78)
+
+/**
+ * The reflected CRC-32 (IEEE 802.3) polynomial.
+ */
+#define CRC32_POLY  UINT32_C(0xEDB88320)
+
+/**
+ * The smallest size of each of the three parts
+ * that are computed interleaved by `crc_sse42`.
+ */
+#define CRC_STREAM  256
+
+
+/**
+ * Tables for computing CRC-32C eight bytes at a time.
+ */
+extern const uint32_t __slibc_crc32c_table[8][256];
+
+/**
+ * Tables for computing CRC-32 eight bytes at a time.
+ */
+extern const uint32_t __slibc_crc32_table[8][256];
+
+
+
+/**
+ * Read a 32-bit little-endian integer.
+ * 
+ * @param   p  The first byte of the integer.
+ * @return     The integer.
+ */
+__attribute__((__pure__, __unused__))
+static uint32_t
+crc_read32(const unsigned char* p)
+{
+  return ((uint32_t)p[0] <<  0) | ((uint32_t)p[1] <<  8) |
+	 ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+
+/**
+ * Update a CRC register with the tables.
+ * 
+ * @param   crc    The CRC register.
+ * @param   p      The data.
+ * @param   size   The size of the data.
+ * @param   table  `__slibc_crc32c_table` or `__slibc_crc32_table`.
+ * @return         The new value of the CRC register.
+ */
+__attribute__((__pure__, __unused__))
+static uint32_t
+crc_table(uint32_t crc, const unsigned char* p, size_t size, const uint32_t table[8][256])
+{
+  uint32_t hi;
+  
+  for (; size >= 8; p += 8, size -= 8)
+    {
+      crc ^= crc_read32(p);
+      hi = crc_read32(p + 4);
+      crc = table[7][(crc >>  0) & 255] ^ table[6][(crc >>  8) & 255] ^
+	    table[5][(crc >> 16) & 255] ^ table[4][(crc >> 24) & 255] ^
+	    table[3][(hi  >>  0) & 255] ^ table[2][(hi  >>  8) & 255] ^
+	    table[1][(hi  >> 16) & 255] ^ table[0][(hi  >> 24) & 255];
+    }
+  for (; size; p++, size--)
+    crc = (crc >> 8) ^ table[0][(crc ^ *p) & 255];
+  return crc;
+}
+
+
+/**
+ * Multiply two polynomials modulo a CRC polynomial.
+ * 
+ * @param   a     One of the polynomials.
+ * @param   b     The other polynomial.
+ * @param   poly  The CRC polynomial.
+ * @return        The product.
+ */
+__attribute__((__const__, __unused__))
+static uint32_t
+crc_mulmod(uint32_t a, uint32_t b, uint32_t poly)
+{
+  uint32_t m, p = 0;
+  
+  for (m = UINT32_C(1) << 31; m; m >>= 1)
+    {
+      if (a & m)
+	p ^= b;
+      b = (b >> 1) ^ ((b & 1) ? poly : 0);
+    }
+  return p;
+}
+
+
+/**
+ * Calculate x raised to the power of 8 times a
+ * number, modulo a CRC polynomial. Multiplying a
+ * CRC register by this appends as many zeroes
+ * as the number to the data.
+ * 
+ * @param   n     The number of bytes.
+ * @param   poly  The CRC polynomial.
+ * @return        x⁸ⁿ modulo `poly`.
+ */
+__attribute__((__const__, __unused__))
+static uint32_t
+crc_shift(size_t n, uint32_t poly)
+{
+  uint32_t r = UINT32_C(1) << 31, b = UINT32_C(1) << 23;
+  
+  for (; n; n >>= 1)
+    {
+      if (n & 1)
+	r = crc_mulmod(r, b, poly);
+      b = crc_mulmod(b, b, poly);
+    }
+  return r;
+}
+
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+# pragma GCC push_options
+# pragma GCC target("sse4.2")
+
+# if defined(__x86_64__)
+typedef uint64_t crc_word_t;
+#  define CRC32C_WORD(crc, p)  ((crc_word_t)__builtin_ia32_crc32di((crc), *(const crc_uword_t*)(p)))
+# else
+typedef uint32_t crc_word_t;
+#  define CRC32C_WORD(crc, p)  ((crc_word_t)__builtin_ia32_crc32si((crc), *(const crc_uword_t*)(p)))
+# endif
+
+/**
+ * `crc_word_t`, but it may be unaligned and alias anything.
+ */
+typedef crc_word_t crc_uword_t __attribute__((__aligned__(1), __may_alias__));
+
+
+/**
+ * Update a CRC-32C register with the CRC32 instruction.
+ * 
+ * @param   crc   The CRC register.
+ * @param   p     The data.
+ * @param   size  The size of the data.
+ * @return        The new value of the CRC register.
+ */
+__attribute__((__pure__, __unused__))
+static uint32_t
+crc_sse42(uint32_t crc, const unsigned char* p, size_t size)
+{
+  crc_word_t c0 = crc, c1 = 0, c2 = 0;
+  size_t i, n;
+  uint32_t k;
+  
+  if (size >= 3 * CRC_STREAM)
+    {
+      n = size / (3 * sizeof(crc_word_t)) * sizeof(crc_word_t);
+      for (i = 0; i < n; i += sizeof(crc_word_t))
+	{
+	  c0 = CRC32C_WORD(c0, p + i);
+	  c1 = CRC32C_WORD(c1, p + n + i);
+	  c2 = CRC32C_WORD(c2, p + 2 * n + i);
+	}
+      /* The CRC of the first part shall be followed by
+       * the second part, so it is shifted past it, and
+       * the same for the CRC of that and the third part. */
+      k = crc_shift(n, CRC32C_POLY);
+      c0 = crc_mulmod(k, (uint32_t)c0, CRC32C_POLY) ^ (uint32_t)c1;
+      c0 = crc_mulmod(k, (uint32_t)c0, CRC32C_POLY) ^ (uint32_t)c2;
+      p += 3 * n, size -= 3 * n;
+    }
+  
+  for (; size >= sizeof(crc_word_t); p += sizeof(crc_word_t), size -= sizeof(crc_word_t))
+    c0 = CRC32C_WORD(c0, p);
+  crc = (uint32_t)c0;
+  for (; size; p++, size--)
+    crc = __builtin_ia32_crc32qi(crc, *p);
+  return crc;
+}
+
+# pragma GCC pop_options
+
+
+
+# pragma GCC push_options
+# pragma GCC target("sse2,pclmul")
+
+/**
+ * 128-bit vector for carry-less multiplication.
+ */
+typedef long long int crc_v2di_t __attribute__((__vector_size__(16)));
+
+/**
+ * `crc_v2di_t`, but it may be unaligned and alias anything.
+ */
+typedef long long int crc_v2diu_t __attribute__((__vector_size__(16), __aligned__(1), __may_alias__));
+
+/**
+ * Carry-less multiplication of one half of a vector
+ * by one half of another vector.
+ * 
+ * @param   a    The first vector.
+ * @param   b    The second vector.
+ * @param   imm  0x00 for the low half of `a` and `b`,
+ *               0x11 for the high half of `a` and `b`,
+ *               0x01 for the high half of `a` and low half of `b`,
+ *               0x10 for the low half of `a` and high half of `b`.
+ * @return       The 128-bit product.
+ */
+# define CRC_CLMUL(a, b, imm)  __builtin_ia32_pclmulqdq128((a), (b), (imm))
+
+/**
+ * Fold a vector into the next 16 bytes of data.
+ * 
+ * @param   x     The vector.
+ * @param   k     The constants for the distance of the fold.
+ * @param   next  The data to fold into.
+ * @return        The folded vector.
+ */
+# define CRC_FOLD(x, k, next)  (CRC_CLMUL(x, k, 0x00) ^ CRC_CLMUL(x, k, 0x11) ^ (next))
+
+/**
+ * Keep only the lowest 32 bits of a vector.
+ */
+# define CRC_LOW32(x)  ((crc_v2di_t){ (x)[0] & 0xFFFFFFFFLL, 0 })
+
+
+/**
+ * Update a CRC-32 register by folding with
+ * carry-less multiplication.
+ * 
+ * The constants are x^(4·128+64), x^(4·128), x^(128+64),
+ * x^128, and x^64, modulo the polynomial, and the
+ * Barrett reduction constants, all bit-reflected.
+ * 
+ * @param   crc   The CRC register.
+ * @param   p     The data.
+ * @param   size  The size of the data, at least 64 and a multiple of 16.
+ * @return        The new value of the CRC register.
+ */
+__attribute__((__pure__, __unused__))
+static uint32_t
+crc_clmul(uint32_t crc, const unsigned char* p, size_t size)
+{
+  crc_v2di_t x0, x1, x2, x3, k, t;
+  unsigned long long int lo, hi;
+  
+  x0 = *(const crc_v2diu_t*)(p + 0) ^ (crc_v2di_t){ crc, 0 };
+  x1 = *(const crc_v2diu_t*)(p + 16);
+  x2 = *(const crc_v2diu_t*)(p + 32);
+  x3 = *(const crc_v2diu_t*)(p + 48);
+  p += 64, size -= 64;
+  
+  k = (crc_v2di_t){ 0x154442BD4LL, 0x1C6E41596LL };
+  for (; size >= 64; p += 64, size -= 64)
+    {
+      x0 = CRC_FOLD(x0, k, *(const crc_v2diu_t*)(p + 0));
+      x1 = CRC_FOLD(x1, k, *(const crc_v2diu_t*)(p + 16));
+      x2 = CRC_FOLD(x2, k, *(const crc_v2diu_t*)(p + 32));
+      x3 = CRC_FOLD(x3, k, *(const crc_v2diu_t*)(p + 48));
+    }
+  
+  k = (crc_v2di_t){ 0x1751997D0LL, 0xCCAA009ELL };
+  x0 = CRC_FOLD(x0, k, x1);
+  x0 = CRC_FOLD(x0, k, x2);
+  x0 = CRC_FOLD(x0, k, x3);
+  for (; size; p += 16, size -= 16)
+    x0 = CRC_FOLD(x0, k, *(const crc_v2diu_t*)(p));
+  
+  /* Fold 128 bits to 64 bits. */
+  t = CRC_CLMUL(k, x0, 0x01);
+  x0 = (crc_v2di_t){ x0[1], 0 } ^ t;
+  
+  /* Fold 64 bits to 32 bits, shifting the vector
+   * right 32 bits and adding the low 32 bits,
+   * multiplied by x^64. */
+  t = CRC_CLMUL(CRC_LOW32(x0), ((crc_v2di_t){ 0x163CD6124LL, 0 }), 0x00);
+  lo = (unsigned long long int)x0[0], hi = (unsigned long long int)x0[1];
+  x0 = (crc_v2di_t){ (long long int)((lo >> 32) | (hi << 32)), (long long int)(hi >> 32) } ^ t;
+  
+  /* Barrett reduction to 32 bits. */
+  k = (crc_v2di_t){ 0x1DB710641LL, 0x1F7011641LL };
+  t = CRC_CLMUL(CRC_LOW32(x0), k, 0x10);
+  t = CRC_CLMUL(CRC_LOW32(t), k, 0x00);
+  x0 ^= t;
+  return (uint32_t)((unsigned long long int)x0[0] >> 32);
+}
+
+# pragma GCC pop_options
+
+#endif
+
+
+#endif
+
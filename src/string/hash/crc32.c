@@ -0,0 +1,52 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "crc.h"
+
+
+
+/**
+ * Calculate the CRC-32 (IEEE 802.3) checksum
+ * of a memory segment, or continue calculating it.
+ * This is the checksum used by zlib and gzip.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   crc      The checksum of the preceding data,
+ *                   0 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t crc32(uint32_t crc, const void* segment, size_t size)
+{
+  const unsigned char* s = segment;
+  crc = ~crc;
+#if defined(__x86_64__) || defined(__i386__)
+  if ((size >= 64) && (__slibc_hwcaps() & HWCAP_PCLMUL))
+    {
+      size_t n = size & ~(size_t)15;
+      crc = crc_clmul(crc, s, n);
+      s += n, size -= n;
+    }
+#endif
+  return ~crc_table(crc, s, size, __slibc_crc32_table);
+}
+
@@ -0,0 +1,46 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "crc.h"
+
+
+
+/**
+ * Calculate the CRC-32C (Castagnoli) checksum
+ * of a memory segment, or continue calculating it.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   crc      The checksum of the preceding data,
+ *                   0 if there is no preceding data.
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The checksum.
+ * 
+ * @since  Always.
+ */
+uint32_t crc32c(uint32_t crc, const void* segment, size_t size)
+{
+  crc = ~crc;
+#if defined(__x86_64__) || defined(__i386__)
+  if (__slibc_hwcaps() & HWCAP_SSE42)
+    return ~crc_sse42(crc, segment, size);
+#endif
+  return ~crc_table(crc, segment, size, __slibc_crc32c_table);
+}
+
@@ -0,0 +1,302 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the helpers for the hash functions.
+ * 
+ * `memhash` is XXH64. It reads 32 bytes at a time into
+ * four independent accumulators, so the multiplications
+ * of the accumulators can be executed in parallel, and
+ * it can be computed incrementally with exactly the same
+ * result as when all input is available at once.
+ * 
+ * `memsiphash` is SipHash-2-4, which is keyed, so that
+ * collisions cannot be constructed without the key. */
+
+
+#ifndef HASH_H
+#define HASH_H
+
+
+#include <stdint.h>
+#include <string.h>
+
+
+
+#define HASH_PRIME1  UINT64_C(0x9E3779B185EBCA87)
+#define HASH_PRIME2  UINT64_C(0xC2B2AE3D27D4EB4F)
+#define HASH_PRIME3  UINT64_C(0x165667B19E3779F9)
+#define HASH_PRIME4  UINT64_C(0x85EBCA77C2B2AE63)
+#define HASH_PRIME5  UINT64_C(0x27D4EB2F165667C5)
+
+
+/**
+ * Rotate a 64-bit integer to the left.
+ */
+#define HASH_ROTL(x, n)  (((x) << (n)) | ((x) >> (64 - (n))))
+
+
+
+/**
+ * Read a 64-bit little-endian integer.
+ * 
+ * @param   p  The first byte of the integer.
+ * @return     The integer.
+ */
+__attribute__((__pure__, __unused__))
+static uint64_t
+hash_read64(const unsigned char* p)
+{
+  return ((uint64_t)p[0] <<  0) | ((uint64_t)p[1] <<  8) |
+	 ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+	 ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+	 ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+
+/**
+ * Read a 32-bit little-endian integer.
+ * 
+ * @param   p  The first byte of the integer.
+ * @return     The integer.
+ */
+__attribute__((__pure__, __unused__))
+static uint64_t
+hash_read32(const unsigned char* p)
+{
+  return ((uint64_t)p[0] <<  0) | ((uint64_t)p[1] <<  8) |
+	 ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24);
+}
+
+
+/**
+ * Mix 8 bytes of input into an accumulator of `memhash`.
+ * 
+ * @param   acc    The accumulator.
+ * @param   input  The input.
+ * @return         The new value of the accumulator.
+ */
+__attribute__((__const__, __unused__))
+static uint64_t
+hash_round(uint64_t acc, uint64_t input)
+{
+  acc += input * HASH_PRIME2;
+  acc = HASH_ROTL(acc, 31);
+  return acc * HASH_PRIME1;
+}
+
+
+/**
+ * Initialise the accumulators of `memhash`.
+ * 
+ * @param  v     The accumulators.
+ * @param  seed  The seed.
+ */
+__attribute__((__unused__))
+static void
+hash_init(uint64_t v[4], uint64_t seed)
+{
+  v[0] = seed + HASH_PRIME1 + HASH_PRIME2;
+  v[1] = seed + HASH_PRIME2;
+  v[2] = seed;
+  v[3] = seed - HASH_PRIME1;
+}
+
+
+/**
+ * Mix all complete 32-byte stripes of the
+ * input into the accumulators of `memhash`.
+ * 
+ * @param   v     The accumulators.
+ * @param   p     The input.
+ * @param   size  The size of the input.
+ * @return        The number of bytes that were mixed in,
+ *                `size` rounded down to a multiple of 32.
+ */
+__attribute__((__unused__))
+static size_t
+hash_stripes(uint64_t v[4], const unsigned char* p, size_t size)
+{
+  uint64_t v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+  size_t i;
+  
+  for (i = 0; i + 32 <= size; i += 32)
+    {
+      v0 = hash_round(v0, hash_read64(p + i +  0));
+      v1 = hash_round(v1, hash_read64(p + i +  8));
+      v2 = hash_round(v2, hash_read64(p + i + 16));
+      v3 = hash_round(v3, hash_read64(p + i + 24));
+    }
+  v[0] = v0, v[1] = v1, v[2] = v2, v[3] = v3;
+  return i;
+}
+
+
+/**
+ * Complete `memhash`.
+ * 
+ * @param   v      The accumulators, ignored if `total` < 32.
+ * @param   seed   The seed.
+ * @param   total  The total size of the input.
+ * @param   p      The input after the last complete stripe.
+ * @param   size   The size of `p`, less than 32.
+ * @return         The hash.
+ */
+__attribute__((__pure__, __unused__))
+static uint64_t
+hash_finish(const uint64_t v[4], uint64_t seed, uint64_t total, const unsigned char* p, size_t size)
+{
+  uint64_t h;
+  int i;
+  
+  if (total >= 32)
+    {
+      h = HASH_ROTL(v[0], 1) + HASH_ROTL(v[1], 7) + HASH_ROTL(v[2], 12) + HASH_ROTL(v[3], 18);
+      for (i = 0; i < 4; i++)
+	{
+	  h ^= hash_round(0, v[i]);
+	  h = h * HASH_PRIME1 + HASH_PRIME4;
+	}
+    }
+  else
+    h = seed + HASH_PRIME5;
+  h += total;
+  
+  for (; size >= 8; p += 8, size -= 8)
+    {
+      h ^= hash_round(0, hash_read64(p));
+      h = HASH_ROTL(h, 27) * HASH_PRIME1 + HASH_PRIME4;
+    }
+  if (size >= 4)
+    {
+      h ^= hash_read32(p) * HASH_PRIME1;
+      h = HASH_ROTL(h, 23) * HASH_PRIME2 + HASH_PRIME3;
+      p += 4, size -= 4;
+    }
+  for (; size; p++, size--)
+    {
+      h ^= *p * HASH_PRIME5;
+      h = HASH_ROTL(h, 11) * HASH_PRIME1;
+    }
+  
+  h ^= h >> 33;
+  h *= HASH_PRIME2;
+  h ^= h >> 29;
+  h *= HASH_PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+
+
+/**
+ * Perform a SipRound.
+ * 
+ * @param  v  The state of `memsiphash`.
+ */
+#define HASH_SIPROUND(v)						\
+  do									\
+    {									\
+      v[0] += v[1], v[1] = HASH_ROTL(v[1], 13), v[1] ^= v[0];		\
+      v[0] = HASH_ROTL(v[0], 32);					\
+      v[2] += v[3], v[3] = HASH_ROTL(v[3], 16), v[3] ^= v[2];		\
+      v[0] += v[3], v[3] = HASH_ROTL(v[3], 21), v[3] ^= v[0];		\
+      v[2] += v[1], v[1] = HASH_ROTL(v[1], 17), v[1] ^= v[2];		\
+      v[2] = HASH_ROTL(v[2], 32);					\
+    }									\
+  while (0)
+
+
+/**
+ * Initialise the state of `memsiphash`.
+ * 
+ * @param  v    The state.
+ * @param  key  The 16-byte key.
+ */
+__attribute__((__unused__))
+static void
+hash_sipinit(uint64_t v[4], const unsigned char* key)
+{
+  uint64_t k0 = hash_read64(key), k1 = hash_read64(key + 8);
+  v[0] = k0 ^ UINT64_C(0x736F6D6570736575);
+  v[1] = k1 ^ UINT64_C(0x646F72616E646F6D);
+  v[2] = k0 ^ UINT64_C(0x6C7967656E657261);
+  v[3] = k1 ^ UINT64_C(0x7465646279746573);
+}
+
+
+/**
+ * Mix all complete 8-byte words of the
+ * input into the state of `memsiphash`.
+ * 
+ * @param   v     The state.
+ * @param   p     The input.
+ * @param   size  The size of the input.
+ * @return        The number of bytes that were mixed in,
+ *                `size` rounded down to a multiple of 8.
+ */
+__attribute__((__unused__))
+static size_t
+hash_sipwords(uint64_t v[4], const unsigned char* p, size_t size)
+{
+  uint64_t m;
+  size_t i;
+  
+  for (i = 0; i + 8 <= size; i += 8)
+    {
+      m = hash_read64(p + i);
+      v[3] ^= m;
+      HASH_SIPROUND(v);
+      HASH_SIPROUND(v);
+      v[0] ^= m;
+    }
+  return i;
+}
+
+
+/**
+ * Complete `memsiphash`.
+ * 
+ * @param   v      The state, it is modified.
+ * @param   total  The total size of the input.
+ * @param   p      The input after the last complete word.
+ * @param   size   The size of `p`, less than 8.
+ * @return         The hash.
+ */
+__attribute__((__unused__))
+static uint64_t
+hash_sipfinish(uint64_t v[4], uint64_t total, const unsigned char* p, size_t size)
+{
+  uint64_t m = total << 56;
+  
+  while (size--)
+    m |= (uint64_t)p[size] << (8 * size);
+  v[3] ^= m;
+  HASH_SIPROUND(v);
+  HASH_SIPROUND(v);
+  v[0] ^= m;
+  
+  v[2] ^= 0xFF;
+  HASH_SIPROUND(v);
+  HASH_SIPROUND(v);
+  HASH_SIPROUND(v);
+  HASH_SIPROUND(v);
+  return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+
+#endif
+
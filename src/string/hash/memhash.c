@@ -0,0 +1,48 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Calculate a fast, non-cryptographic, hash
+ * of a memory segment. The hash is XXH64.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   seed     Arbitrary value that selects the hash function.
+ * @return           The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t memhash(const void* segment, size_t size, uint64_t seed)
+{
+  const unsigned char* s = segment;
+  uint64_t v[4];
+  size_t n = 0;
+  if (size >= 32)
+    {
+      hash_init(v, seed);
+      n = hash_stripes(v, s, size);
+    }
+  return hash_finish(v, seed, size, s + n, size - n);
+}
+
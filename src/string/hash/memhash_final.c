@@ -0,0 +1,38 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Get the result of an incremental `memhash` computation.
+ * More data may be added to the computation afterwards.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   state  The state.
+ * @return         The hash of all data added so far.
+ * 
+ * @since  Always.
+ */
+uint64_t memhash_final(const struct memhash_state* state)
+{
+  return hash_finish(state->v, state->seed, state->total, state->buffer, (size_t)(state->total % 32));
+}
+
@@ -0,0 +1,39 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Start an incremental `memhash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state  The state to initialise.
+ * @param  seed   Arbitrary value that selects the hash function.
+ * 
+ * @since  Always.
+ */
+void memhash_init(struct memhash_state* state, uint64_t seed)
+{
+  hash_init(state->v, seed);
+  state->seed = seed;
+  state->total = 0;
+}
+
@@ -0,0 +1,53 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Add data to an incremental `memhash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state    The state.
+ * @param  segment  The data.
+ * @param  size     The size of the data.
+ * 
+ * @since  Always.
+ */
+void memhash_update(struct memhash_state* state, const void* segment, size_t size)
+{
+  const unsigned char* s = segment;
+  size_t buffered = (size_t)(state->total % 32), n;
+  state->total += size;
+  
+  if (buffered)
+    {
+      n = 32 - buffered < size ? 32 - buffered : size;
+      memcpy(state->buffer + buffered, s, n);
+      if (buffered + n < 32)
+	return;
+      hash_stripes(state->v, state->buffer, 32);
+      s += n, size -= n;
+    }
+  
+  n = hash_stripes(state->v, s, size);
+  memcpy(state->buffer, s + n, size - n);
+}
+
@@ -0,0 +1,46 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Calculate a keyed hash of a memory segment, that is
+ * resistant to collisions constructed without the key.
+ * The hash is SipHash-2-4.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   key      The 16-byte key, which should be secret and random.
+ * @return           The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t memsiphash(const void* segment, size_t size, const void* key)
+{
+  const unsigned char* s = segment;
+  uint64_t v[4];
+  size_t n;
+  hash_sipinit(v, key);
+  n = hash_sipwords(v, s, size);
+  return hash_sipfinish(v, size, s + n, size - n);
+}
+
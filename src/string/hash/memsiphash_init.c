@@ -0,0 +1,38 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "hash.h"
+
+
+
+/**
+ * Start an incremental `memsiphash` computation.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state  The state to initialise.
+ * @param  key    The 16-byte key, which should be secret and random.
+ * 
+ * @since  Always.
+ */
+void memsiphash_init(struct memsiphash_state* state, const void* key)
+{
+  hash_sipinit(state->v, key);
+  state->total = 0;
+}
+
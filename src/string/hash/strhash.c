@@ -0,0 +1,39 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+
+
+/**
+ * Calculate a fast, non-cryptographic, hash of a
+ * string. This is `memhash` for the string without
+ * its terminating NUL byte.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   string  The string.
+ * @param   seed    Arbitrary value that selects the hash function.
+ * @return          The hash.
+ * 
+ * @since  Always.
+ */
+uint64_t strhash(const char* string, uint64_t seed)
+{
+  return memhash(string, strlen(string), seed);
+}
+
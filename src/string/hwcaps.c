@@ -0,0 +1,169 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "hwcaps.h"
+#include <stddef.h>
+
+
+
+/**
+ * The process's environment variables.
+ */
+extern char** environ;
+
+
+/**
+ * Flag for `hwcaps`: the value has been computed.
+ */
+#define HWCAP_KNOWN  0x8000U
+
+
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * Run the CPUID instruction.
+ * 
+ * @param  leaf     The leaf to query.
+ * @param  subleaf  The subleaf to query.
+ * @param  regs     Output parameter for EAX, EBX, ECX, and EDX.
+ */
+static void
+cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+  __asm__ __volatile__ ("cpuid"
+			: "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3])
+			: "a"(leaf), "c"(subleaf));
+}
+
+
+/**
+ * Detect the instruction set extensions of the CPU.
+ * 
+ * @return  Bitwise OR of the `HWCAP_*` flags.
+ */
+static unsigned int
+detect(void)
+{
+  unsigned int regs[4], max, xcr0, rc = 0;
+  
+  cpuid(0, 0, regs);
+  max = regs[0];
+  if (max < 1)
+    return 0;
+  
+  cpuid(1, 0, regs);
+  if (regs[3] & (1U << 26))
+    rc |= HWCAP_SSE2;
+  if (regs[2] & (1U << 20))
+    rc |= HWCAP_SSE42;
+  if (regs[2] & (1U << 1))
+    rc |= HWCAP_PCLMUL;
+  
+  /* AVX registers are only usable if the operating
+   * system saves them, which XGETBV reports, and it
+   * is only available if OSXSAVE is set. */
+  if ((max < 7) || !(regs[2] & (1U << 27)) || !(regs[2] & (1U << 28)))
+    return rc;
+  __asm__ __volatile__ ("xgetbv" : "=a"(xcr0) : "c"(0) : "edx");
+  if ((xcr0 & 0x06) != 0x06)
+    return rc;
+  
+  cpuid(7, 0, regs);
+  if (regs[1] & (1U << 5))
+    rc |= HWCAP_AVX2;
+  if (((xcr0 & 0xE6) == 0xE6) && (regs[1] & (1U << 16)) && (regs[1] & (1U << 30)))
+    rc |= HWCAP_AVX512BW;
+  
+  return rc;
+}
+#else
+# define detect()  0U
+#endif
+
+
+/**
+ * Get the capabilities that SLIBC_HWCAPS permits.
+ * 
+ * This function cannot use `getenv`, nor any other
+ * function that uses `__slibc_hwcaps`, as it would
+ * recurse into itself.
+ * 
+ * @return  Bitwise OR of the `HWCAP_*` flags.
+ */
+__attribute__((__pure__))
+static unsigned int
+permitted(void)
+{
+  static const char* const names[] = { "baseline", "sse2", "avx2", "avx512" };
+  static const unsigned int masks[] =
+    {
+      0,
+      HWCAP_SSE2,
+      HWCAP_SSE2 | HWCAP_SSE42 | HWCAP_PCLMUL | HWCAP_AVX2,
+      HWCAP_SSE2 | HWCAP_SSE42 | HWCAP_PCLMUL | HWCAP_AVX2 | HWCAP_AVX512BW,
+    };
+  static const char prefix[] = "SLIBC_HWCAPS=";
+  char** env;
+  const char* v;
+  size_t i, j;
+  
+  for (env = environ; env && *env; env++)
+    {
+      for (i = 0; prefix[i] && ((*env)[i] == prefix[i]); i++);
+      if (prefix[i])
+	continue;
+      v = *env + i;
+      for (j = 0; j < sizeof(names) / sizeof(*names); j++)
+	{
+	  for (i = 0; names[j][i] && (v[i] == names[j][i]); i++);
+	  if (!names[j][i] && !v[i])
+	    return masks[j];
+	}
+    }
+  
+  return ~0U;
+}
+
+
+/**
+ * Get the instruction set extensions, that the
+ * library may use, on the running CPU.
+ * 
+ * The result can be restricted with the environment
+ * variable SLIBC_HWCAPS, which names the widest
+ * instruction set the library may use: "baseline",
+ * "sse2", "avx2", or "avx512". SSE4.2 and PCLMULQDQ
+ * are permitted with "avx2" and "avx512".
+ * 
+ * @return  Bitwise OR of the `HWCAP_*` flags.
+ */
+unsigned int __slibc_hwcaps(void)
+{
+  static unsigned int caps = 0;
+  unsigned int rc = __atomic_load_n(&caps, __ATOMIC_RELAXED);
+  
+  /* Computing the value twice, in concurrent
+   * threads, is harmless, they will agree. */
+  if (!(rc & HWCAP_KNOWN))
+    {
+      rc = (detect() & permitted()) | HWCAP_KNOWN;
+      __atomic_store_n(&caps, rc, __ATOMIC_RELAXED);
+    }
+  
+  return rc & ~HWCAP_KNOWN;
+}
+
@@ -0,0 +1,83 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines how the functions in the library find
+ * which instruction set extensions they may use, and other
+ * data that is shared between the string functions. It
+ * is private to slibc, and is not installed. */
+
+
+#ifndef HWCAPS_H
+#define HWCAPS_H
+
+
+
+/**
+ * Flag for `__slibc_hwcaps`: SSE2 is available.
+ */
+#define HWCAP_SSE2      0x0001U
+
+/**
+ * Flag for `__slibc_hwcaps`: AVX2 is available,
+ * and enabled by the operating system.
+ */
+#define HWCAP_AVX2      0x0002U
+
+/**
+ * Flag for `__slibc_hwcaps`: AVX-512F and AVX-512BW
+ * are available, and enabled by the operating system.
+ */
+#define HWCAP_AVX512BW  0x0004U
+
+/**
+ * Flag for `__slibc_hwcaps`: SSE4.2, which
+ * has the CRC32 instruction, is available.
+ */
+#define HWCAP_SSE42     0x0008U
+
+/**
+ * Flag for `__slibc_hwcaps`: PCLMULQDQ,
+ * carry-less multiplication, is available.
+ */
+#define HWCAP_PCLMUL    0x0010U
+
+/**
+ * Get the instruction set extensions, that the
+ * library may use, on the running CPU.
+ * 
+ * The result can be restricted with the environment
+ * variable SLIBC_HWCAPS, which names the widest
+ * instruction set the library may use: "baseline",
+ * "sse2", "avx2", or "avx512". SSE4.2 and PCLMULQDQ
+ * are permitted with "avx2" and "avx512".
+ * 
+ * @return  Bitwise OR of the `HWCAP_*` flags.
+ */
+unsigned int __slibc_hwcaps(void) __attribute__((__pure__));
+
+
+/**
+ * Maps each byte to itself, except the ASCII
+ * uppercase letters, which are mapped to their
+ * lowercase counterparts.
+ */
+extern const unsigned char __slibc_fold[256];
+
+
+
+#endif
+
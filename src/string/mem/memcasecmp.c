@@ -16,7 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
-#include <ctype.h>
+#include "../dispatch.h"
 
 
 
@@ -36,17 +36,6 @@
  */
 int memcasecmp(const void* a, const void* b, size_t size)
 {
-  const signed char* s1 = a;
-  const signed char* s2 = b;
-  int c1, c2;
-  for (; size--; s1++, s2++)
-    if (*s1 != *s2)
-      {
-	c1 = isalpha(*s1) ? tolower(*s1) : (int)*s1;
-	c2 = isalpha(*s2) ? tolower(*s2) : (int)*s2;
-	if ((c1 -= c2))
-	  return c1;
-      }
-  return 0;
+  return DISPATCH(compare_memcasecmp)(a, b, size, COMPARE_CASE);
 }
 
@@ -16,9 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
-#include <unistd.h>
-#include <alloca.h>
-#include <ctype.h>
+#include "../dispatch.h"
 
 
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -37,11 +38,7 @@
  */
 void* (memccpy)(void* restrict whither, const void* restrict whence, int c, size_t size)
 {
-  char* stop = (memchr)(whence, c, size);
-  void* r = NULL;
-  if (stop != NULL)
-    size = (size_t)(stop - (const char*)whence), r = whither + size;
-  memcpy(whither, whence, size);
-  return r;
+  const char* stop = DISPATCH(copy_memccpy)(whither, whence, c, size);
+  return stop == NULL ? NULL : (whither + (stop - (const char*)whence));
 }
 
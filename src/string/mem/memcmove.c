@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -39,8 +40,15 @@
  */
 void* (memcmove)(void* whither, const void* whence, int c, size_t size)
 {
-  char* stop = (memchr)(whence, c, size);
+  const char* stop;
   void* r = NULL;
+  if ((size_t)(whither - whence) >= size)
+    {
+      /* Copying forwards is safe. */
+      stop = DISPATCH(copy_memccpy)(whither, whence, c, size);
+      return stop == NULL ? NULL : (whither + (stop - (const char*)whence));
+    }
+  stop = (memchr)(whence, c, size);
   if (stop != NULL)
     size = (size_t)(stop - (const char*)whence), r = whither + size;
   memmove(whither, whence, size);
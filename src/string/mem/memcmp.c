@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -32,13 +33,6 @@
  */
 int memcmp(const void* a, const void* b, size_t size)
 {
-  const unsigned char* s1 = a;
-  const unsigned char* s2 = b;
-  while (size--)
-    if (*s1 == *s2)
-      s1++, s2++;
-    else
-      return (int)(*s1 - *s2);
-  return 0;
+  return DISPATCH(compare_memcmp)(a, b, size);
 }
 
@@ -0,0 +1,37 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Count the occurrences of a byte in a memory segment.
+ * 
+ * @param   segment  The memory segment.
+ * @param   c        The sought after byte.
+ * @param   size     The size of the memory segment.
+ * @return           The number of occurrences of `c`.
+ * 
+ * @since  Always.
+ */
+size_t memcount(const void* segment, int c, size_t size)
+{
+  return DISPATCH(scan_memcount)(segment, c, size);
+}
+
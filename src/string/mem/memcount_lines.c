@@ -0,0 +1,42 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Count the lines in a memory segment. The last
+ * line is counted even if it is not terminated
+ * by a line feed, but it is not counted if it
+ * is empty.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The number of lines in `segment`.
+ * 
+ * @since  Always.
+ */
+size_t memcount_lines(const void* segment, size_t size)
+{
+  const char* s = segment;
+  if (!size)
+    return 0;
+  return DISPATCH(scan_memcount)(s, '\n', size) + (s[size - 1] != '\n');
+}
+
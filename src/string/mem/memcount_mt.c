@@ -0,0 +1,105 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "parallel.h"
+#include "../dispatch.h"
+
+
+
+/**
+ * A count shared between the threads of `memcount_mt`.
+ */
+struct memcount_mt_job
+{
+  const char* segment;
+  size_t size;
+  size_t chunk;
+  int c;
+  
+  /**
+   * The position of the next chunk.
+   */
+  size_t next;
+  
+  /**
+   * The number of occurrences found so far.
+   */
+  size_t count;
+};
+
+
+/**
+ * Count the occurrences in the chunks of a memory segment.
+ * 
+ * @param   data  The count, as a `struct memcount_mt_job*`.
+ * @return        `NULL`.
+ */
+static void* memcount_mt_worker(void* data)
+{
+  struct memcount_mt_job* job = data;
+  size_t start, length, n = 0;
+  
+  for (;;)
+    {
+      start = parallel_next(&job->next, job->chunk);
+      if (start >= job->size)
+	break;
+      length = job->size - start < job->chunk ? job->size - start : job->chunk;
+      n += DISPATCH(scan_memcount)(job->segment + start, job->c, length);
+    }
+  __atomic_fetch_add(&job->count, n, __ATOMIC_RELAXED);
+  return NULL;
+}
+
+
+/**
+ * Count the occurrences of a byte in a memory segment,
+ * using multiple threads for large memory segments.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment   The memory segment.
+ * @param   c         The sought after byte.
+ * @param   size      The size of the memory segment.
+ * @param   nthreads  The maximum number of threads to use,
+ *                    including the calling thread, 0 for
+ *                    one per online processor. slibc cannot
+ *                    create threads yet, so currently only
+ *                    the calling thread is used.
+ * @return            The number of occurrences of `c`.
+ * 
+ * @since  Always.
+ */
+size_t memcount_mt(const void* segment, int c, size_t size, size_t nthreads)
+{
+  struct memcount_mt_job job;
+  
+  nthreads = parallel_threads(size, nthreads, &job.chunk);
+  if (nthreads == 1)
+    return DISPATCH(scan_memcount)(segment, c, size);
+  
+  job.segment = segment;
+  job.size = size;
+  job.c = c;
+  job.next = 0;
+  job.count = 0;
+  parallel_run(memcount_mt_worker, &job, nthreads);
+  
+  return job.count;
+}
+
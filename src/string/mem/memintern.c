@@ -0,0 +1,406 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Interned segments are kept in a hash table that is split
+ * into shards, selected by the high half of the hash, so
+ * that threads that insert different segments seldom wait
+ * for each other. Lookups are lock-free: a slot is set once,
+ * after the segment it points to has been written, and when
+ * a shard's table grows, the new table is published after
+ * it has been filled. The old table is deliberately leaked:
+ * other threads may still be reading it, and nothing tells
+ * when they are done. As the tables double in size, the
+ * leaked tables are together smaller than the current one.
+ * Insertions lock the shard, and look the segment up again,
+ * as it may have been inserted, or the table may have grown,
+ * meanwhile.
+ * 
+ * The segments are hashed with SipHash, with a key that
+ * is chosen randomly once per process, so that segments
+ * that collide cannot be chosen in advance to make the
+ * lookups slow.
+ * 
+ * The segments are copied into arenas, one per shard, that
+ * are never freed, so the returned pointers remain valid
+ * for the lifetime of the process. */
+
+
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+#include <sys/random.h>
+
+
+
+/**
+ * The number of shards, must be a power of two.
+ */
+#define INTERN_SHARDS  64
+
+/**
+ * The initial number of slots in a shard's
+ * table, must be a power of two.
+ */
+#define INTERN_SLOTS  256
+
+/**
+ * The size of the chunks that the arenas are
+ * allocated in. Segments larger than a quarter
+ * of this are allocated on their own.
+ */
+#define INTERN_CHUNK  ((size_t)64 << 10)
+
+/**
+ * The largest number of times `INTERN_PAUSE`
+ * is used between two attempts to lock a shard.
+ */
+#define INTERN_BACKOFF  64
+
+
+/**
+ * Tell the processor that the thread is spinning.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+# define INTERN_PAUSE()  __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+# define INTERN_PAUSE()  __asm__ __volatile__ ("yield" ::: "memory")
+#else
+# define INTERN_PAUSE()  __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+
+
+/**
+ * An interned segment.
+ */
+struct intern_segment
+{
+  /**
+   * The hash of the segment.
+   */
+  uint64_t hash;
+  
+  /**
+   * The size of the segment.
+   */
+  size_t size;
+  
+  /**
+   * The segment, followed by a NUL byte.
+   */
+  char data[];
+};
+
+
+/**
+ * The hash table of a shard.
+ */
+struct intern_table
+{
+  /**
+   * The number of slots, a power of two.
+   */
+  size_t capacity;
+  
+  /**
+   * The slots, `NULL` if unused.
+   */
+  struct intern_segment* slots[];
+};
+
+
+/**
+ * A shard of the hash table.
+ */
+struct intern_shard
+{
+  /**
+   * The current table, `NULL` until the
+   * first segment in the shard is interned.
+   */
+  struct intern_table* table;
+  
+  /**
+   * The number of used slots in `table`.
+   */
+  size_t count;
+  
+  /**
+   * The unused part of the current arena chunk.
+   */
+  char* arena;
+  
+  /**
+   * The size of `arena`.
+   */
+  size_t arena_size;
+  
+  /**
+   * Whether an insertion is in progress.
+   */
+  char lock;
+} __attribute__((__aligned__(64)));
+
+
+
+/**
+ * The shards.
+ */
+static struct intern_shard shards[INTERN_SHARDS];
+
+/**
+ * The key for `memsiphash`.
+ */
+static uint64_t intern_key[2];
+
+/**
+ * 0 before `intern_key` is chosen,
+ * 1 while it is being chosen, and 2
+ * once it has been chosen.
+ */
+static char intern_key_state = 0;
+
+
+
+/**
+ * Lock a shard, waiting, with exponential
+ * backoff, while another thread holds it.
+ * 
+ * @param  shard  The shard.
+ */
+static void
+intern_lock(struct intern_shard* shard)
+{
+  unsigned backoff = 1, i;
+  
+  while (__atomic_test_and_set(&shard->lock, __ATOMIC_ACQUIRE))
+    do
+      {
+	for (i = backoff; i--;)
+	  INTERN_PAUSE();
+	if (backoff < INTERN_BACKOFF)
+	  backoff *= 2;
+      }
+    while (__atomic_load_n(&shard->lock, __ATOMIC_RELAXED));
+}
+
+
+/**
+ * Get the key for `memsiphash`, and choose it
+ * the first time this function is called.
+ * 
+ * The key is read with `getrandom`. If that fails,
+ * for example because the kernel does not have it,
+ * the key is derived from addresses that are
+ * randomised when the process is started, which
+ * is weaker, but better than a fixed key.
+ * 
+ * @return  The key.
+ */
+static const void*
+intern_get_key(void)
+{
+  char expected = 0;
+  uint64_t addresses[3];
+  
+  if (__atomic_load_n(&intern_key_state, __ATOMIC_ACQUIRE) == 2)
+    return intern_key;
+  
+  if (!__atomic_compare_exchange_n(&intern_key_state, &expected, 1, 0,
+				   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      while (__atomic_load_n(&intern_key_state, __ATOMIC_ACQUIRE) != 2)
+	INTERN_PAUSE();
+      return intern_key;
+    }
+  
+  if (getrandom(intern_key, sizeof(intern_key), GRND_NONBLOCK) != (ssize_t)sizeof(intern_key))
+    {
+      addresses[0] = (uint64_t)(size_t)addresses;
+      addresses[1] = (uint64_t)(size_t)shards;
+      addresses[2] = (uint64_t)(size_t)&malloc;
+      intern_key[0] = memhash(addresses, sizeof(addresses), intern_key[0]);
+      intern_key[1] = memhash(addresses, sizeof(addresses), ~intern_key[0]);
+    }
+  
+  __atomic_store_n(&intern_key_state, 2, __ATOMIC_RELEASE);
+  return intern_key;
+}
+
+
+
+/**
+ * Find the slot of a segment in a table,
+ * or the slot where it shall be inserted.
+ * 
+ * @param   table    The table.
+ * @param   hash     The hash of the segment.
+ * @param   segment  The segment.
+ * @param   size     The size of the segment.
+ * @param   found    Output parameter for the interned segment,
+ *                   `NULL` if the segment was not found. The
+ *                   slot itself may be set by another thread
+ *                   at any time, unless the shard is locked.
+ * @return           The slot.
+ */
+static struct intern_segment**
+intern_find(struct intern_table* table, uint64_t hash, const void* segment,
+	    size_t size, struct intern_segment** found)
+{
+  size_t mask = table->capacity - 1, i = (size_t)hash & mask;
+  struct intern_segment* s;
+  
+  /* The table is never more than half full. */
+  for (;; i = (i + 1) & mask)
+    {
+      s = __atomic_load_n(table->slots + i, __ATOMIC_ACQUIRE);
+      if (!s || ((s->hash == hash) && (s->size == size) && !memcmp(s->data, segment, size)))
+	return *found = s, table->slots + i;
+    }
+}
+
+
+/**
+ * Make room for one more segment in a shard,
+ * which must be locked.
+ * 
+ * The old table is not freed, as other threads
+ * may still be reading it, see the top of
+ * this file.
+ * 
+ * @param   shard  The shard.
+ * @return         Zero on success, -1 on error.
+ */
+static int
+intern_grow(struct intern_shard* shard)
+{
+  struct intern_table* old = shard->table;
+  struct intern_table* new;
+  size_t capacity = old ? 2 * old->capacity : INTERN_SLOTS;
+  size_t i, j;
+  
+  if (old && (2 * (shard->count + 1) <= old->capacity))
+    return 0;
+  
+  new = calloc(1, offsetof(struct intern_table, slots) + capacity * sizeof(*new->slots));
+  if (new == NULL)
+    return -1;
+  new->capacity = capacity;
+  for (i = 0; old && (i < old->capacity); i++)
+    if (old->slots[i])
+      {
+	for (j = (size_t)old->slots[i]->hash; new->slots[j & (capacity - 1)]; j++);
+	new->slots[j & (capacity - 1)] = old->slots[i];
+      }
+  
+  /* `old` is leaked on purpose, it may still be in use. */
+  __atomic_store_n(&shard->table, new, __ATOMIC_RELEASE);
+  return 0;
+}
+
+
+/**
+ * Allocate an interned segment in a shard's
+ * arena, the shard must be locked.
+ * 
+ * @param   shard  The shard.
+ * @param   size   The size of the segment.
+ * @return         The interned segment, `NULL` on error.
+ */
+static struct intern_segment*
+intern_alloc(struct intern_shard* shard, size_t size)
+{
+  size_t n = offsetof(struct intern_segment, data) + size + 1;
+  void* r;
+  
+  if (size > SIZE_MAX - 2 * sizeof(struct intern_segment))
+    return errno = ENOMEM, NULL;
+  n = (n + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+  
+  if (n > INTERN_CHUNK / 4)
+    return malloc(n);
+  if (n > shard->arena_size)
+    {
+      shard->arena = malloc(INTERN_CHUNK);
+      if (shard->arena == NULL)
+	return shard->arena_size = 0, NULL;
+      shard->arena_size = INTERN_CHUNK;
+    }
+  r = shard->arena;
+  shard->arena += n;
+  shard->arena_size -= n;
+  return r;
+}
+
+
+/**
+ * Get the canonical copy of a memory segment. Equal
+ * segments have the same canonical copy, so interned
+ * segments can be compared by their addresses.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The canonical copy of `segment`, it is
+ *                   followed by a NUL byte, and it is valid
+ *                   until the process exits. `NULL` is
+ *                   returned on error and `errno` is set
+ *                   to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+const void* memintern(const void* segment, size_t size)
+{
+  uint64_t hash = memsiphash(segment, size, intern_get_key());
+  struct intern_shard* shard = shards + (size_t)(hash >> 32) % INTERN_SHARDS;
+  struct intern_table* table;
+  struct intern_segment** slot;
+  struct intern_segment* s;
+  
+  table = __atomic_load_n(&shard->table, __ATOMIC_ACQUIRE);
+  if (table && (intern_find(table, hash, segment, size, &s), s))
+    return s->data;
+  
+  intern_lock(shard);
+  
+  /* Only grow the table if the segment is new. */
+  s = NULL;
+  if (shard->table)
+    intern_find(shard->table, hash, segment, size, &s);
+  if ((s == NULL) && !intern_grow(shard))
+    {
+      slot = intern_find(shard->table, hash, segment, size, &s);
+      if ((s == NULL) && (s = intern_alloc(shard, size)))
+	{
+	  s->hash = hash;
+	  s->size = size;
+	  memcpy(s->data, segment, size);
+	  s->data[size] = '\0';
+	  __atomic_store_n(slot, s, __ATOMIC_RELEASE);
+	  shard->count++;
+	}
+    }
+  
+  __atomic_clear(&shard->lock, __ATOMIC_RELEASE);
+  return s == NULL ? NULL : s->data;
+}
+
@@ -0,0 +1,60 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <slibc/internals.h>
+#include "needle.h"
+#include "../dispatch.h"
+
+
+
+/**
+ * Prepare a substring for being searched for in many
+ * memory segments, so that this is done only once.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   needle         The sought after substring.
+ * @param   needle_length  The length of `needle`.
+ * @return                 The prepared substring, `NULL` on error. It
+ *                         shall be deallocated with `memmem_free`.
+ *                         It does not refer to `needle`.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+struct memmem_needle* memmem_compile(const void* __needle, size_t needle_length)
+{
+  const char* needle = __needle;
+  struct memmem_needle* compiled;
+  size_t size;
+  
+  MEM_OVERFLOW(uaddl, sizeof(*compiled), needle_length, &size);
+  compiled = malloc(size);
+  if (compiled == NULL)
+    return NULL;
+  compiled->length = needle_length;
+  memcpy(compiled->needle, needle, needle_length);
+  
+#define COMPILE
+#include "substring.h"
+#undef COMPILE
+}
+
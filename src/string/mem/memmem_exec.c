@@ -0,0 +1,58 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "needle.h"
+#include "../dispatch.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
+
+
+
+/**
+ * Find the first occurrence of a substring
+ * prepared with `memmem_compile`.
+ * This search is case sensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   compiled         The sought after substring.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @return                   Pointer to the first occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+void* (memmem_exec)(const struct memmem_needle* compiled, const void* __haystack,
+		    size_t haystack_length)
+{
+  const char* haystack = __haystack;
+  const char* needle = compiled->needle;
+  size_t needle_length = compiled->length;
+  
+  if (haystack_length < needle_length)
+    return NULL;
+  if (haystack_length == needle_length)
+    return !(memcmp)(haystack, needle, haystack_length) ? haystack : NULL;
+  
+#define COMPILED
+#include "substring.h"
+#undef COMPILED
+}
+
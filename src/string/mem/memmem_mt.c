@@ -0,0 +1,133 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdint.h>
+#include "parallel.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
+
+
+
+/**
+ * A search shared between the threads of `memmem_mt`.
+ */
+struct memmem_mt_job
+{
+  const char* haystack;
+  const char* needle;
+  size_t needle_length;
+  
+  /**
+   * The number of positions where the needle can begin.
+   */
+  size_t positions;
+  
+  /**
+   * The number of positions per chunk.
+   */
+  size_t chunk;
+  
+  /**
+   * The first position of the next chunk.
+   */
+  size_t next;
+  
+  /**
+   * The position of the leftmost found
+   * occurrence, `SIZE_MAX` if none.
+   */
+  size_t found;
+};
+
+
+/**
+ * Search the chunks of a haystack.
+ * 
+ * @param   data  The search, as a `struct memmem_mt_job*`.
+ * @return        `NULL`.
+ */
+static void* memmem_mt_worker(void* data)
+{
+  struct memmem_mt_job* job = data;
+  size_t start, length;
+  const char* r;
+  
+  for (;;)
+    {
+      start = parallel_next(&job->next, job->chunk);
+      /* The chunks are taken in order, so if this chunk
+       * is after an occurrence, so are the rest of them. */
+      if ((start >= job->positions) || (start >= __atomic_load_n(&job->found, __ATOMIC_RELAXED)))
+	return NULL;
+      /* The chunk contains the positions where the needle
+       * can begin, so it overlaps with the next chunk by
+       * all but one byte of the needle. */
+      length = job->positions - start < job->chunk ? job->positions - start : job->chunk;
+      length += job->needle_length - 1;
+      r = (memmem)(job->haystack + start, length, job->needle, job->needle_length);
+      if (r != NULL)
+	parallel_min(&job->found, (size_t)(r - job->haystack));
+    }
+}
+
+
+/**
+ * Finds the first occurrence of a substring,
+ * using multiple threads for large haystacks.
+ * This search is case sensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @param   nthreads         The maximum number of threads to use,
+ *                           including the calling thread, 0 for
+ *                           one per online processor. slibc cannot
+ *                           create threads yet, so currently only
+ *                           the calling thread is used.
+ * @return                   Pointer to the first occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+void* (memmem_mt)(const void* haystack, size_t haystack_length,
+		  const void* needle, size_t needle_length, size_t nthreads)
+{
+  struct memmem_mt_job job;
+  
+  if (!needle_length || (haystack_length < needle_length))
+    return (memmem)(haystack, haystack_length, needle, needle_length);
+  
+  job.positions = haystack_length - needle_length + 1;
+  nthreads = parallel_threads(job.positions, nthreads, &job.chunk);
+  if (nthreads == 1)
+    return (memmem)(haystack, haystack_length, needle, needle_length);
+  
+  job.haystack = haystack;
+  job.needle = needle;
+  job.needle_length = needle_length;
+  job.next = 0;
+  job.found = SIZE_MAX;
+  parallel_run(memmem_mt_worker, &job, nthreads);
+  
+  return job.found == SIZE_MAX ? NULL : (job.haystack + job.found);
+}
+
@@ -0,0 +1,57 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+
+
+/**
+ * Find the first occurrence of any of a set of needles.
+ * 
+ * When the same needles are used for many haystacks,
+ * use `memmem_multi_compile` and `memmem_multi_exec`.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   needles          The needles.
+ * @param   lengths          The length of each needle, `NULL` if the
+ *                           needles are NUL-terminated strings.
+ * @param   count            The number of needles.
+ * @param   which            Output parameter for the index of the found
+ *                           needle, may be `NULL`, see `memmem_multi_exec`.
+ * @return                   The first position in `haystack` where any
+ *                           of the needles occur, `NULL` if none or on
+ *                           error, in which case `errno` is set.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+void* (memmem_multi)(const void* haystack, size_t haystack_length, const void* const* needles,
+		     const size_t* lengths, size_t count, size_t* which)
+{
+  struct memmem_multi* m = memmem_multi_compile(needles, lengths, count);
+  void* r;
+  if (m == NULL)
+    return NULL;
+  r = (memmem_multi_exec)(m, haystack, haystack_length, which);
+  memmem_multi_free(m);
+  return r;
+}
+
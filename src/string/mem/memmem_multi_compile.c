@@ -0,0 +1,153 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <slibc/internals.h>
+#include "multi.h"
+
+
+
+/**
+ * Compile a set of needles, so that a haystack can be
+ * searched for all of them at once.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   needles  The needles.
+ * @param   lengths  The length of each needle, `NULL` if the
+ *                   needles are NUL-terminated strings.
+ * @param   count    The number of needles.
+ * @return           The compiled needles, `NULL` on error. It shall
+ *                   be deallocated with `memmem_multi_free`.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+struct memmem_multi* memmem_multi_compile(const void* const* needles, const size_t* lengths,
+					  size_t count)
+{
+  unsigned short int class[256];
+  struct memmem_multi* m;
+  const unsigned char* n;
+  size_t i, j, c, u, v, f, len, head, tail;
+  size_t total = 1, classes = 1, states = 1, size;
+  size_t* fail;
+  size_t* queue;
+  
+  for (c = 0; c < 256; c++)
+    class[c] = 0;
+  for (i = 0; i < count; i++)
+    {
+      n = needles[i];
+      len = lengths ? lengths[i] : strlen(needles[i]);
+      MEM_OVERFLOW(uaddl, total, len, &total);
+      for (j = 0; j < len; j++)
+	if (!class[n[j]])
+	  class[n[j]] = (unsigned short int)classes++;
+    }
+  
+  /* `total` is an upper bound of the number of states. */
+  MEM_OVERFLOW(umull, total, classes + 3, &size);
+  MEM_OVERFLOW(umull, size, sizeof(size_t), &size);
+  MEM_OVERFLOW(uaddl, size, sizeof(*m), &size);
+  m = malloc(size);
+  if (m == NULL)
+    return NULL;
+  fail = malloc(2 * total * sizeof(size_t));
+  if (fail == NULL)
+    return free(m), NULL;
+  queue = fail + total;
+  
+  m->next   = (size_t*)(m + 1);
+  m->needle = m->next + total * classes;
+  m->output = m->needle + total;
+  m->depth  = m->output + total;
+  memcpy(m->class, class, sizeof(class));
+  memset(m->next, 0, total * classes * sizeof(size_t));
+  m->classes = classes;
+  m->longest = 0;
+  m->empty = SIZE_MAX;
+  m->needle[0] = SIZE_MAX;
+  m->output[0] = 0;
+  m->depth[0] = 0;
+  byteset_clear(&m->first);
+  
+  /* Build the trie of the needles. */
+  for (i = 0; i < count; i++)
+    {
+      n = needles[i];
+      len = lengths ? lengths[i] : strlen(needles[i]);
+      if (len > m->longest)
+	m->longest = len;
+      if (!len)
+	{
+	  if (m->empty == SIZE_MAX)
+	    m->empty = i;
+	  continue;
+	}
+      byteset_add(&m->first, n[0]);
+      for (u = 0, j = 0; j < len; j++)
+	{
+	  c = class[n[j]];
+	  if (!m->next[u * classes + c])
+	    {
+	      v = states++;
+	      m->next[u * classes + c] = v;
+	      m->needle[v] = SIZE_MAX;
+	      m->depth[v] = j + 1;
+	    }
+	  u = m->next[u * classes + c];
+	}
+      if (m->needle[u] == SIZE_MAX)
+	m->needle[u] = i;
+    }
+  
+  /* Add the failure transitions. The states are visited
+   * in breadth-first order, so when a state is visited,
+   * its failure state, which is shallower, is complete.
+   * Until then, the only transitions out of a state are
+   * those of the trie. */
+  head = tail = 0;
+  for (c = 0; c < classes; c++)
+    if ((v = m->next[c]))
+      fail[v] = 0, m->output[v] = 0, queue[tail++] = v;
+  while (head < tail)
+    {
+      u = queue[head++];
+      for (c = 0; c < classes; c++)
+	{
+	  v = m->next[u * classes + c];
+	  f = m->next[fail[u] * classes + c];
+	  if (!v)
+	    {
+	      m->next[u * classes + c] = f;
+	      continue;
+	    }
+	  fail[v] = f;
+	  m->output[v] = m->needle[f] != SIZE_MAX ? f : m->output[f];
+	  queue[tail++] = v;
+	}
+    }
+  
+  free(fail);
+  return m;
+}
+
@@ -0,0 +1,70 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdint.h>
+#include "multi.h"
+
+
+
+/**
+ * Find every occurrence of each of a set of needles.
+ * Empty needles are ignored, and if two needles are
+ * identical, only the one with the lowest index is
+ * reported.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   automaton        The needles, compiled with `memmem_multi_compile`.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   callback         Function that is called for each occurrence,
+ *                           in the order they end, with the index of the
+ *                           needle, the offset of the occurrence in
+ *                           `haystack`, and `data`. If it returns non-zero,
+ *                           the search is stopped.
+ * @param   data             User-defined data for `callback`.
+ * @return                   The number of times `callback` was called.
+ * 
+ * @since  Always.
+ */
+size_t memmem_multi_each(const struct memmem_multi* automaton, const void* haystack, size_t haystack_length,
+			 int (*callback)(size_t which, size_t offset, void* data), void* data)
+{
+  const struct memmem_multi* m = automaton;
+  const unsigned char* h = haystack;
+  size_t i, u = 0, s, n = 0;
+  const char* p;
+  
+  for (i = 0; i < haystack_length; i++)
+    {
+      if (!u)
+	{
+	  p = DISPATCH(byteset_memscan)((const char*)h + i, &m->first, 0, haystack_length - i);
+	  if (p == NULL)
+	    break;
+	  i = (size_t)((const unsigned char*)p - h);
+	}
+      u = m->next[u * m->classes + m->class[h[i]]];
+      for (s = m->needle[u] != SIZE_MAX ? u : m->output[u]; s; s = m->output[s])
+	if (n++, callback(m->needle[s], i + 1 - m->depth[s], data))
+	  return n;
+    }
+  
+  return n;
+}
+
@@ -0,0 +1,86 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdint.h>
+#include "multi.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
+
+
+
+/**
+ * Find the first occurrence of any of a set of needles.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   automaton        The needles, compiled with `memmem_multi_compile`.
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`.
+ * @param   which            Output parameter for the index of the found
+ *                           needle, may be `NULL`. If multiple needles
+ *                           occur at the returned position, the one with
+ *                           the lowest index is selected.
+ * @return                   The first position in `haystack` where any
+ *                           of the needles occur, `NULL` if none.
+ * 
+ * @since  Always.
+ */
+void* (memmem_multi_exec)(const struct memmem_multi* automaton, const void* haystack,
+			  size_t haystack_length, size_t* which)
+{
+  const struct memmem_multi* m = automaton;
+  const unsigned char* h = haystack;
+  size_t i, u = 0, s, start;
+  size_t best = SIZE_MAX, best_needle = m->empty;
+  const char* p;
+  
+  if (m->empty != SIZE_MAX)
+    best = 0;
+  
+  /* Occurrences are found in the order they end, so an
+   * earlier occurrence may be found later, but once the
+   * longest needle cannot start before the best found
+   * occurrence, the search is over. */
+  for (i = 0; i < haystack_length; i++)
+    {
+      if (!u)
+	{
+	  p = DISPATCH(byteset_memscan)((const char*)h + i, &m->first, 0, haystack_length - i);
+	  if (p == NULL)
+	    break;
+	  i = (size_t)((const unsigned char*)p - h);
+	}
+      if ((best != SIZE_MAX) && (i >= best + m->longest))
+	break;
+      u = m->next[u * m->classes + m->class[h[i]]];
+      for (s = m->needle[u] != SIZE_MAX ? u : m->output[u]; s; s = m->output[s])
+	{
+	  start = i + 1 - m->depth[s];
+	  if ((start < best) || ((start == best) && (m->needle[s] < best_needle)))
+	    best = start, best_needle = m->needle[s];
+	}
+    }
+  
+  if (best == SIZE_MAX)
+    return NULL;
+  if (which != NULL)
+    *which = best_needle;
+  return h + best;
+}
+
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -31,14 +32,7 @@
  */
 void* memmove(void* whither, const void* whence, size_t size)
 {
-  char* d = whither;
-  const char* s = whence;
-  if ((size_t)(d - s) < size)
-    while (size--)
-      d[size] = s[size];
-  else
-    while (size--)
-      *d++ = *s++;
+  DISPATCH(copy_memmove)(whither, whence, size);
   return whither;
 }
 
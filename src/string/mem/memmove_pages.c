@@ -0,0 +1,95 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "pages.h"
+
+
+
+/**
+ * Copy a memory segment to another, possibly overlapping,
+ * segment, by moving its pages rather than copying them.
+ * 
+ * If the segments overlap, the pages are moved in pieces
+ * as large as the distance between the segments, so that
+ * each piece is moved to an address that is not in use by
+ * the pieces that have not been moved yet. If the distance
+ * is short, the segment is copied instead. Each piece of
+ * the destination is checked just before it is replaced,
+ * as it may overlap pieces of the source that have
+ * already been moved, but never pieces that have not.
+ * 
+ * @param   whither  The destination memory segment.
+ * @param   whence   The source memory segment.
+ * @param   size     The number of bytes to copy.
+ * @return           `whither` is returned, `NULL` on error.
+ * 
+ * @throws  Any error specified for mmap(2) or mremap(2).
+ * 
+ * @since  Always.
+ */
+void* memmove_pages(void* whither, void* whence, size_t size)
+{
+  char* d = whither;
+  char* s = whence;
+  size_t head, middle, tail, distance, i, n;
+  void* taken;
+  int r;
+  
+  if ((d == s) || !pages_split(d, s, size, &head, &middle))
+    return memmove(d, s, size);
+  distance = d < s ? (size_t)(s - d) : (size_t)(d - s);
+  if ((distance < size) && (distance < PAGES_THRESHOLD))
+    return memmove(d, s, size);
+  tail = size - head - middle;
+  
+  if (d < s)
+    {
+      memmove(d, s, head);
+      for (i = head; i < head + middle; i += n)
+	{
+	  n = head + middle - i < distance ? head + middle - i : distance;
+	  if (!pages_discardable(d + i, n) || !(r = pages_take(s + i, n, &taken)))
+	    {
+	      memmove(d + i, s + i, size - i);
+	      return whither;
+	    }
+	  if ((r < 0) || pages_put(d + i, taken, n))
+	    return NULL;
+	}
+      memmove(d + i, s + i, tail);
+    }
+  else
+    {
+      memmove(d + head + middle, s + head + middle, tail);
+      for (i = head + middle; i > head; i -= n)
+	{
+	  n = i - head < distance ? i - head : distance;
+	  if (!pages_discardable(d + i - n, n) || !(r = pages_take(s + i - n, n, &taken)))
+	    {
+	      memmove(d, s, i);
+	      return whither;
+	    }
+	  if ((r < 0) || pages_put(d + i - n, taken, n))
+	    return NULL;
+	}
+      memmove(d, s, head);
+    }
+  
+  return whither;
+}
+
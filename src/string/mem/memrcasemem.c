@@ -0,0 +1,54 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
+
+
+
+/**
+ * Finds the last occurrence of a substring.
+ * This search is case insensitive.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack         The string to search.
+ * @param   haystack_length  The number of character to search.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`.
+ * @return                   Pointer to the last occurrence of
+ *                           the substring, `NULL` if not found.
+ * 
+ * @since  Always.
+ */
+void* (memrcasemem)(const void* __haystack, size_t haystack_length,
+		    const void* __needle, size_t needle_length)
+{
+  const char* haystack = __haystack;
+  const char* needle = __needle;
+  if (haystack_length < needle_length)
+    return NULL;
+  if (haystack_length == needle_length)
+    return !(memcasecmp)(haystack, needle, haystack_length) ? haystack : NULL;
+#define CASE
+#define RIGHT
+#include "substring.h"
+}
+
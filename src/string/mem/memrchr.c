@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -39,10 +40,6 @@
  */
 void* (memrchr)(const void* segment, int c, size_t size)
 {
-  char* s = segment;
-  while (size--)
-    if (s[size] == c)
-      return s + size;
-  return NULL;
+  return DISPATCH(scan_memrchr)(segment, c, size);
 }
 
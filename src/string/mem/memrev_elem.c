@@ -0,0 +1,42 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Reverse the order of the elements in an array.
+ * The bytes in each element are not reordered.
+ * 
+ * @param   segment  The array.
+ * @param   count    The number of elements.
+ * @param   width    The size of each element.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memrev_elem(void* segment, size_t count, size_t width)
+{
+  if ((width <= 8) && width && !(width & (width - 1)))
+    DISPATCH(copy_memrev)(segment, count, width);
+  else
+    copy_reverse(segment, count, width);
+  return segment;
+}
+
@@ -0,0 +1,80 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * The greatest rotation, in either direction, that is
+ * made by copying the bytes that wrap around to a
+ * buffer, rather than by reversing the segment.
+ */
+#define ROTATE_BUFFER  256
+
+
+
+/**
+ * Rotate a memory segment to the left, so that
+ * the byte at index `shift` becomes the first byte.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   shift    The number of bytes to rotate by,
+ *                   it may be greater than `size`.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memrotate(void* segment, size_t size, size_t shift)
+{
+  void (*reverse)(char*, size_t, size_t);
+  char buffer[ROTATE_BUFFER];
+  char* s = segment;
+  
+  if (!size || !(shift %= size))
+    return segment;
+  
+  /* A short rotation in either direction only moves a
+   * few bytes past the end, so they are put aside, and
+   * the rest is moved once. Otherwise, the two parts are
+   * reversed, and then the whole segment is reversed,
+   * so every byte is moved twice, but in place. */
+  if (shift <= ROTATE_BUFFER)
+    {
+      memcpy(buffer, s, shift);
+      memmove(s, s + shift, size - shift);
+      memcpy(s + size - shift, buffer, shift);
+    }
+  else if (size - shift <= ROTATE_BUFFER)
+    {
+      memcpy(buffer, s + shift, size - shift);
+      memmove(s + size - shift, s, shift);
+      memcpy(s, buffer, size - shift);
+    }
+  else
+    {
+      reverse = &DISPATCH(copy_memrev);
+      reverse(s, shift, 1);
+      reverse(s + shift, size - shift, 1);
+      reverse(s, size, 1);
+    }
+  
+  return segment;
+}
+
@@ -0,0 +1,66 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "tok.h"
+
+
+
+/**
+ * Find the next field in a memory segment, without
+ * modifying the memory segment. This is a variant of
+ * `strsep` for memory segments that are not terminated
+ * by a NUL byte and may be read-only.
+ * 
+ * Unlike `memtok`, empty fields are returned, and a
+ * memory segment of the size zero contains one field.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   state    The delimiters, prepared with `memtok_init`.
+ *                   Its `position` member is updated to the
+ *                   position after the returned field and
+ *                   its delimiter.
+ * @param   offset   Output parameter for the offset of the field.
+ * @param   length   Output parameter for the length of the field.
+ * @return           1 if a field was found, 0 if there
+ *                   are no more fields.
+ * 
+ * @since  Always.
+ */
+int memsep(const void* segment, size_t size, struct memtok_state* restrict state,
+	   size_t* restrict offset, size_t* restrict length)
+{
+  const char* s = segment;
+  const char* next;
+  size_t pos = state->position;
+  
+  if (pos > size)
+    return 0;
+  
+  next = DISPATCH(byteset_memscan)(s + pos, TOK_SET(state), 0, size - pos);
+  *offset = pos;
+  if (next == NULL)
+    *length = size - pos, state->position = size + 1;
+  else
+    *length = (size_t)(next - s) - pos, state->position = (size_t)(next - s) + 1;
+  
+  return 1;
+}
+
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -31,9 +32,7 @@
  */
 void* memset(void* segment, int c, size_t size)
 {
-  char* s = segment;
-  while (size--)
-    *s++ = (char)c;
+  DISPATCH(copy_memset)(segment, c, size);
   return segment;
 }
 
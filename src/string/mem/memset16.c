@@ -0,0 +1,40 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Override a memory segment with a repeated 16-bit integer.
+ * 
+ * @param   segment  The beginning of the memory segment.
+ * @param   c        The integer.
+ * @param   count    The number of integers in the memory segment.
+ * @return           `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset16(void* segment, uint16_t c, size_t count)
+{
+  char pattern[COPY_PATTERN_SIZE];
+  copy_pattern(pattern, (const char*)&c, sizeof(c));
+  DISPATCH(copy_memset_pattern)(segment, pattern, sizeof(c), count * sizeof(c));
+  return segment;
+}
+
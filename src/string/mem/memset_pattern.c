@@ -0,0 +1,78 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * The number of bytes, at least, that are repeated at a
+ * time by `memset_pattern` when the pattern cannot be
+ * filled with blocks. It is small enough to stay in the
+ * cache while it is being repeated.
+ */
+#define PATTERN_RUN  4096
+
+
+
+/**
+ * Override a memory segment with a repeated pattern.
+ * 
+ * @param   segment       The beginning of the memory segment.
+ * @param   size          The size of the memory segment.
+ * @param   pattern       The pattern, it must not overlap with `segment`.
+ * @param   pattern_size  The size of the pattern, the last repetition of
+ *                        the pattern is truncated if it does not fit.
+ * @return                `segment` is returned.
+ * 
+ * @since  Always.
+ */
+void* memset_pattern(void* segment, size_t size, const void* pattern, size_t pattern_size)
+{
+  char block[COPY_PATTERN_SIZE];
+  char* d = segment;
+  size_t n, run, k;
+  
+  if (!size || !pattern_size)
+    return segment;
+  
+  if ((pattern_size <= 8) && !(pattern_size & (pattern_size - 1)))
+    {
+      copy_pattern(block, pattern, pattern_size);
+      DISPATCH(copy_memset_pattern)(d, block, pattern_size, size);
+      return segment;
+    }
+  
+  /* Write the pattern once, and then copy what has been
+   * written, doubling it, until it is large enough to
+   * be copied efficiently. It is always a whole number
+   * of repetitions, so it can be copied to the end of
+   * what has been written without changing the phase. */
+  n = run = pattern_size < size ? pattern_size : size;
+  memcpy(d, pattern, n);
+  while (n < size)
+    {
+      k = run < size - n ? run : size - n;
+      memcpy(d + n, d, k);
+      n += k;
+      if (run < PATTERN_RUN)
+	run = n;
+    }
+  return segment;
+}
+
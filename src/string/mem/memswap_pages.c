@@ -0,0 +1,75 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "pages.h"
+
+
+
+/**
+ * Swap the contents of two non-overlapping memory
+ * segments, by swapping their pages rather than
+ * copying them.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        0 on success, -1 on error.
+ * 
+ * @throws  Any error specified for mmap(2) or mremap(2).
+ * 
+ * @since  Always.
+ */
+int memswap_pages(void* a, void* b, size_t size)
+{
+  char* x = a;
+  char* y = b;
+  size_t head, middle;
+  void* taken_x;
+  void* taken_y;
+  int r, saved_errno;
+  
+  if (!pages_split(x, y, size, &head, &middle))
+    goto copy;
+  if (!(r = pages_take(x + head, middle, &taken_x)))
+    goto copy;
+  if (r < 0)
+    return -1;
+  if ((r = pages_take(y + head, middle, &taken_y)) <= 0)
+    {
+      saved_errno = errno;
+      if (pages_put(x + head, taken_x, middle))
+	return -1;
+      if (r < 0)
+	return errno = saved_errno, -1;
+      goto copy;
+    }
+  if (pages_put(x + head, taken_y, middle))
+    return saved_errno = errno, munmap(taken_x, middle), errno = saved_errno, -1;
+  if (pages_put(y + head, taken_x, middle))
+    return -1;
+  
+  memswap(x, y, head);
+  head += middle;
+  memswap(x + head, y + head, size - head);
+  return 0;
+  
+ copy:
+  memswap(x, y, size);
+  return 0;
+}
+
@@ -0,0 +1,69 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "tok.h"
+
+
+
+/**
+ * Find the next token in a memory segment, without
+ * modifying the memory segment. This is a variant of
+ * `strtok_r` for memory segments that are not terminated
+ * by a NUL byte and may be read-only.
+ * 
+ * Unlike `memsep`, empty tokens are skipped.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @param   state    The delimiters, prepared with `memtok_init`.
+ *                   Its `position` member is updated to the
+ *                   position after the returned token and
+ *                   its delimiter.
+ * @param   offset   Output parameter for the offset of the token.
+ * @param   length   Output parameter for the length of the token.
+ * @return           1 if a token was found, 0 if there
+ *                   are no more tokens.
+ * 
+ * @since  Always.
+ */
+int memtok(const void* segment, size_t size, struct memtok_state* restrict state,
+	   size_t* restrict offset, size_t* restrict length)
+{
+  const char* s = segment;
+  const char* start;
+  const char* next;
+  const struct byteset* set = TOK_SET(state);
+  
+  if (state->position >= size)
+    return state->position = size, 0;
+  
+  start = DISPATCH(byteset_memscan)(s + state->position, set, 1, size - state->position);
+  if (start == NULL)
+    return state->position = size, 0;
+  next = DISPATCH(byteset_memscan)(start, set, 0, size - (size_t)(start - s));
+  *offset = (size_t)(start - s);
+  if (next == NULL)
+    *length = size - *offset, state->position = size;
+  else
+    *length = (size_t)(next - start), state->position = (size_t)(next - s) + 1;
+  
+  return 1;
+}
+
@@ -0,0 +1,46 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "tok.h"
+
+
+
+/**
+ * Prepare a set of delimiters for `memsep` and `memtok`,
+ * so that it is only done once for all fields.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param  state             The state to initialise.
+ * @param  delimiters        The bytes that separate fields,
+ *                           duplicates are allowed.
+ * @param  delimiters_size   The number of bytes in `delimiters`.
+ * 
+ * @since  Always.
+ */
+void memtok_init(struct memtok_state* state, const void* delimiters, size_t delimiters_size)
+{
+  const unsigned char* d = delimiters;
+  struct byteset* set = TOK_SET(state);
+  
+  byteset_clear(set);
+  while (delimiters_size--)
+    byteset_add(set, *d++);
+  state->position = 0;
+}
+
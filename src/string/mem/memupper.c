@@ -0,0 +1,42 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Copy a memory segment, but convert all
+ * ASCII letters to uppercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination memory segment, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source memory segment.
+ * @param   size  The size of the memory segments.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+void* memupper(void* dest, const void* src, size_t size)
+{
+  DISPATCH(transform_upper)(dest, src, size);
+  return dest;
+}
+
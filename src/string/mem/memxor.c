@@ -0,0 +1,45 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * XOR a memory segment with another memory segment.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination memory segment, may be `src`
+ *                or `key`, but may not otherwise overlap with them.
+ * @param   src   The source memory segment.
+ * @param   key   The memory segment to XOR `src` with.
+ * @param   size  The size of the memory segments.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+void* memxor(void* dest, const void* src, const void* key, size_t size)
+{
+  if (dest == key)
+    DISPATCH(transform_xor)(dest, key, src, size);
+  else
+    DISPATCH(transform_xor)(dest, src, key, size);
+  return dest;
+}
+
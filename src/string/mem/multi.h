@@ -0,0 +1,93 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the structure of the needles compiled
+ * by `memmem_multi_compile`, which the functions that use
+ * them share. */
+
+
+#ifndef MULTI_H
+#define MULTI_H
+
+
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * A set of needles compiled into an Aho–Corasick
+ * automaton, see `memmem_multi_compile`.
+ */
+struct memmem_multi
+{
+  /**
+   * The number of byte classes. Bytes that do not
+   * occur in any needle share the class 0.
+   */
+  size_t classes;
+  
+  /**
+   * The length of the longest needle.
+   */
+  size_t longest;
+  
+  /**
+   * The index of the first empty needle, `SIZE_MAX` if none.
+   */
+  size_t empty;
+  
+  /**
+   * The class of each byte.
+   */
+  unsigned short int class[256];
+  
+  /**
+   * The first bytes of the needles. In the initial state,
+   * the automaton skips directly to the next of these.
+   */
+  struct byteset first;
+  
+  /**
+   * `next[state * classes + class]` is the state the
+   * automaton enters when it reads a byte of the class
+   * `class` in the state `state`. The initial state is 0.
+   */
+  size_t* next;
+  
+  /**
+   * For each state, the index of the first needle
+   * that ends at the state, `SIZE_MAX` if none.
+   */
+  size_t* needle;
+  
+  /**
+   * For each state, the state, of the longest proper
+   * suffix of the state's string, at which a needle
+   * ends, 0 if none.
+   */
+  size_t* output;
+  
+  /**
+   * For each state, the length of the state's string.
+   */
+  size_t* depth;
+};
+
+
+#endif
+
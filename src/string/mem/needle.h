@@ -0,0 +1,67 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the structure of the needles prepared
+ * by `memmem_compile`, which the functions that use them
+ * share. */
+
+
+#ifndef NEEDLE_H
+#define NEEDLE_H
+
+
+#include <stddef.h>
+
+
+
+/**
+ * A needle prepared for searching,
+ * see `memmem_compile`.
+ */
+struct memmem_needle
+{
+  /**
+   * The length of the needle.
+   */
+  size_t length;
+  
+  /**
+   * The beginning of the right-hand side of
+   * the critical factorisation of the needle.
+   */
+  size_t suffix;
+  
+  /**
+   * The period of the right-hand side of
+   * the critical factorisation of the needle.
+   */
+  size_t period;
+  
+  /**
+   * Whether `period` is the period of the entire needle.
+   */
+  int periodic;
+  
+  /**
+   * A copy of the needle.
+   */
+  char needle[];
+};
+
+
+#endif
+
@@ -0,0 +1,212 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the helpers for the functions that
+ * move memory by moving pages between addresses, with
+ * `mremap`, rather than by copying them. This is only
+ * possible if the source and the destination have the
+ * same offset into a page, and only worthwhile if at
+ * least `PAGES_THRESHOLD` bytes are moved per call.
+ * The bytes before the first page boundary, and after
+ * the last, are copied. Pages are only moved between
+ * private anonymous mappings, anything else, such as
+ * a shared or file-backed mapping, would change kind
+ * if its pages were replaced. If that cannot be
+ * verified, or if `mremap` fails, for example because
+ * the kernel does not support `MREMAP_DONTUNMAP`, the
+ * pages are copied too. */
+
+
+#ifndef PAGES_H
+#define PAGES_H
+
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+
+/**
+ * The least number of bytes that are moved
+ * with one call to `mremap`.
+ */
+#define PAGES_THRESHOLD  ((size_t)1 << 20)
+
+
+
+/**
+ * Return the pagesize. If it it cannot be retrieved,
+ * use a fallback value.
+ * 
+ * @return  The pagesize, or a fallback value.
+ */
+__attribute__((__unused__))
+static size_t
+pages_size(void)
+{
+  static size_t pagesize = 0;
+  long r;
+  if (pagesize == 0)
+    {
+      r = sysconf(_SC_PAGESIZE);
+      pagesize = (size_t)(r <= 0 ? 4096 : r);
+    }
+  return pagesize;
+}
+
+
+/**
+ * Split two memory segments into the part before
+ * the first page boundary, whole pages, and the
+ * part after the last page boundary.
+ * 
+ * @param   a       One of the memory segments.
+ * @param   b       The other memory segment.
+ * @param   size    The size of the segments.
+ * @param   head    Output parameter for the number of
+ *                  bytes before the first page boundary.
+ * @param   middle  Output parameter for the number of
+ *                  bytes in the whole pages.
+ * @return          Whether the segments have the same offset
+ *                  into a page, and at least `PAGES_THRESHOLD`
+ *                  bytes of whole pages. If 0 is returned,
+ *                  the segments shall be copied, and `*head`
+ *                  and `*middle` are not set.
+ */
+__attribute__((__unused__))
+static int
+pages_split(const void* a, const void* b, size_t size, size_t* head, size_t* middle)
+{
+  size_t pagesize = pages_size();
+  size_t offset = (size_t)a & (pagesize - 1);
+  
+  if (offset != ((size_t)b & (pagesize - 1)))
+    return 0;
+  if (size < PAGES_THRESHOLD + pagesize)
+    return 0;
+  
+  *head = offset ? pagesize - offset : 0;
+  *middle = (size - *head) & ~(pagesize - 1);
+  return *middle >= PAGES_THRESHOLD;
+}
+
+
+/**
+ * Check that memory, whose contents are no longer
+ * needed, is in private anonymous mappings.
+ * 
+ * `MADV_FREE` is used for the check, as it fails
+ * for any other kind of mapping, and for unmapped
+ * memory, but it also allows the kernel to discard
+ * the contents of the memory.
+ * 
+ * @param   start  The memory, page-aligned.
+ * @param   size   The number of bytes, a multiple
+ *                 of the pagesize.
+ * @return         1 if the memory is in private anonymous
+ *                 mappings, 0 if it is not, or if it
+ *                 cannot be determined.
+ */
+__attribute__((__unused__))
+static int
+pages_discardable(void* start, size_t size)
+{
+  return !madvise(start, size, MADV_FREE);
+}
+
+
+/**
+ * Move pages, taken with `pages_take`, to their
+ * destination, replacing the pages there. The
+ * destination must have been checked with
+ * `pages_discardable`, or be memory that
+ * has been taken with `pages_take`.
+ * 
+ * @param   whither  The destination, page-aligned.
+ * @param   taken    The pages, as returned by `pages_take`.
+ * @param   size     The number of bytes, a multiple
+ *                   of the pagesize.
+ * @return           0 on success, -1 on error, in which
+ *                   case the pages have been lost, and
+ *                   the destination may be unmapped.
+ * 
+ * @throws  Any error specified for mmap(2).
+ */
+__attribute__((__unused__))
+static int
+pages_put(void* whither, void* taken, size_t size)
+{
+  int saved_errno;
+  
+  if (mremap(taken, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, whither) != MAP_FAILED)
+    return 0;
+  
+  /* The destination may have been unmapped before the move failed. */
+  if (mmap(whither, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+    return saved_errno = errno, munmap(taken, size), errno = saved_errno, -1;
+  memcpy(whither, taken, size);
+  munmap(taken, size);
+  return 0;
+}
+
+
+/**
+ * Move whole pages to a new address, selected by the kernel.
+ * The source remains mapped, but its pages are replaced
+ * with pages that are filled with zeroes when accessed.
+ * 
+ * Moving the pages directly to the destination with
+ * `MREMAP_FIXED` is not safe, as the kernel may unmap
+ * the destination before it finds that the source
+ * cannot be moved. Once the pages are in a mapping
+ * of their own, they can always be moved.
+ * 
+ * Whether the source is in private anonymous mappings
+ * can only be checked once its pages have been taken,
+ * if it is not, the pages are moved back.
+ * 
+ * @param   whence  The pages, page-aligned.
+ * @param   size    The number of bytes, a multiple
+ *                  of the pagesize.
+ * @param   taken   Output parameter for the new address
+ *                  of the pages.
+ * @return          1 if the pages were taken, 0 if nothing
+ *                  has been moved, -1 on error, in which
+ *                  case the pages could not be moved back
+ *                  and have been lost.
+ * 
+ * @throws  Any error specified for mremap(2).
+ */
+__attribute__((__unused__))
+static int
+pages_take(void* whence, size_t size, void** taken)
+{
+  void* r = mremap(whence, size, size, MREMAP_MAYMOVE | MREMAP_DONTUNMAP);
+  if (r == MAP_FAILED)
+    return 0;
+  if (pages_discardable(whence, size))
+    return *taken = r, 1;
+  if (mremap(r, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, whence) == MAP_FAILED)
+    return -1;
+  return 0;
+}
+
+
+#endif
+
@@ -0,0 +1,143 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the helpers for the functions that
+ * split a large memory segment into chunks and process
+ * them on multiple threads. The threads take chunks in
+ * order, from a shared counter, until there are no more
+ * chunks, or until the rest of the chunks are no longer
+ * of interest. The calling thread processes chunks too,
+ * so if no thread can be created, the calling thread
+ * processes all of them.
+ * 
+ * slibc cannot create threads yet, so
+ * `PARALLEL_MAX_THREADS` is 1, and every segment is
+ * processed directly by the calling thread. Once slibc
+ * has threads, only `PARALLEL_MAX_THREADS` and
+ * `parallel_run` need to change. */
+
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+
+#include <string.h>
+
+
+
+/**
+ * The smallest chunk size.
+ */
+#define PARALLEL_CHUNK  ((size_t)1 << 20)
+
+/**
+ * The maximum number of threads, including
+ * the calling thread.
+ */
+#define PARALLEL_MAX_THREADS  1
+
+
+
+/**
+ * Select the number of threads, and the chunk size,
+ * for processing a memory segment.
+ * 
+ * @param   size      The number of bytes to process.
+ * @param   nthreads  The number of threads requested,
+ *                    0 for `PARALLEL_MAX_THREADS`.
+ * @param   chunk     Output parameter for the chunk size.
+ * @return            The number of threads to use, including
+ *                    the calling thread. If 1 is returned,
+ *                    the segment shall be processed directly,
+ *                    and `*chunk` is not set.
+ */
+__attribute__((__unused__))
+static size_t
+parallel_threads(size_t size, size_t nthreads, size_t* chunk)
+{
+  size_t chunks;
+  
+  if (!nthreads || (nthreads > PARALLEL_MAX_THREADS))
+    nthreads = PARALLEL_MAX_THREADS;
+  if ((nthreads < 2) || (size < 2 * PARALLEL_CHUNK))
+    return 1;
+  
+  /* Use a few chunks per thread, so that the work
+   * is balanced if some threads are delayed. */
+  *chunk = size / (4 * nthreads);
+  if (*chunk < PARALLEL_CHUNK)
+    *chunk = PARALLEL_CHUNK;
+  chunks = size / *chunk + (size % *chunk != 0);
+  return nthreads < chunks ? nthreads : chunks;
+}
+
+
+/**
+ * Run a function on multiple threads, and
+ * wait for all of them to return.
+ * 
+ * @param  worker    The function, it is called once per
+ *                   thread, and shall take chunks until
+ *                   there are no more.
+ * @param  job       The argument for `worker`.
+ * @param  nthreads  The number of threads, including the
+ *                   calling thread.
+ */
+__attribute__((__unused__))
+static void
+parallel_run(void* (*worker)(void*), void* job, size_t nthreads)
+{
+  (void) nthreads;
+  worker(job);
+}
+
+
+/**
+ * Take the next chunk.
+ * 
+ * @param   next   The position of the next chunk,
+ *                 shared between the threads.
+ * @param   chunk  The chunk size.
+ * @return         The position of the taken chunk.
+ */
+__attribute__((__unused__))
+static size_t
+parallel_next(size_t* next, size_t chunk)
+{
+  return __atomic_fetch_add(next, chunk, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * Lower a value shared between the threads,
+ * if a new value is less than it.
+ * 
+ * @param  value  The shared value.
+ * @param  new    The new value.
+ */
+__attribute__((__unused__))
+static void
+parallel_min(size_t* value, size_t new)
+{
+  size_t old = __atomic_load_n(value, __ATOMIC_RELAXED);
+  while ((new < old) &&
+	 !__atomic_compare_exchange_n(value, &old, new, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+
+#endif
+
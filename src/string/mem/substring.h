@@ -24,63 +24,248 @@
  * search shall be used. RIGHT shall be defined iff
  * the last occurrence shall be find. WIDE shall be
  * defined iff wide characters are used. It is assumed
- * that `needle_length` <= `haystack_length` */
+ * that `needle_length` <= `haystack_length`. If WIDE
+ * is not defined, "../dispatch.h" must have been
+ * included.
+ * 
+ * `haystack_length` may be `SIZE_MAX` if the haystack
+ * is known to contain the needle, in which case no
+ * character after the end of the first occurrence
+ * is read. This is not allowed if RIGHT is defined.
+ * 
+ * If COMPILE is defined, the needle is only prepared
+ * for searching: `compiled` shall be defined as a
+ * pointer to a structure with the `size_t` members
+ * `suffix` and `period`, and the `int` member
+ * `periodic`, which are set, and `compiled` is
+ * returned; `haystack` is not used. If COMPILED is
+ * defined, `compiled` shall be defined in the same
+ * way, and these members are read from it instead
+ * of being computed. */
 
 
-/* The Knuth–Morris–Pratt algorithm. */
+/* The Crochemore–Perrin Two-Way algorithm, which runs
+ * in linear time and constant space. Short needles are
+ * searched for with the block at a time kernels in
+ * "../substr.h" instead, unless WIDE is defined.
+ * 
+ * If RIGHT is defined, the haystack and the needle are
+ * read backwards, so the last occurrence in the haystack
+ * is the first occurrence in the reversed haystack. */
 
 
 /**
- * Test whether to characters are equal.
- * Case-sensitivity depends on `CASE` being defined.
+ * Get the value of a character that is used
+ * in comparisons. Case-sensitivity depends on
+ * `CASE` being defined. The type of the value
+ * is `CHTYPE`.
  * 
- * @param   a  One of the characters.
- * @param   b  The other character.
- * @return     1 if `a` and `b` or equal, 0 otherwise.
- *             The comparison is case-insensitive if
+ * @param   c  The character.
+ * @return     The character, in lower case if
  *             `CASE` is defined.
  */
-#if !defined(CASE)
-# define CHREQ(a, b)  (a == b)
+#if !defined(CASE) && !defined(WIDE)
+# define CHFOLD(c)  ((unsigned char)(c))
+# define CHTYPE     unsigned char
+#elif !defined(CASE)
+# define CHFOLD(c)  (c)
+# define CHTYPE     wchar_t
 #elif !defined(WIDE)
-# define CHREQ(a, b)  ((islower(a) ? tolower(a) : (a)) == tolower(b))
+# define CHFOLD(c)  (__slibc_fold[(unsigned char)(c)])
+# define CHTYPE     unsigned char
+#else
+# define CHFOLD(c)  towlower(c)
+# define CHTYPE     wint_t
+#endif
+
+
+/**
+ * Get a character in the needle, as returned by `CHFOLD`.
+ * 
+ * @param   i  The index of the character, counted
+ *             from the end if `RIGHT` is defined.
+ * @return     The character.
+ */
+#ifndef RIGHT
+# define NEEDLE(i)  CHFOLD(needle[i])
+#else
+# define NEEDLE(i)  CHFOLD(needle[needle_length - 1 - (i)])
+#endif
+
+
+/**
+ * Get a character in the haystack, as returned by `CHFOLD`.
+ * 
+ * @param   i  The index of the character, counted
+ *             from the end if `RIGHT` is defined.
+ * @return     The character.
+ */
+#ifndef RIGHT
+# define HAYSTACK(i)  CHFOLD(haystack[i])
+#else
+# define HAYSTACK(i)  CHFOLD(haystack[haystack_length - 1 - (i)])
+#endif
+
+
+/**
+ * Get the occurrence of the needle at a position.
+ * 
+ * @param   j  The position of the occurrence, counted
+ *             from the end if `RIGHT` is defined.
+ * @return     The beginning of the occurrence.
+ */
+#ifndef RIGHT
+# define FOUND(j)  (haystack + (j))
 #else
-# define CHREQ(a, b)  ((iswlower(a) ? towlower(a) : (a)) == towlower(b))
+# define FOUND(j)  (haystack + (haystack_length - needle_length - (j)))
 #endif
 
 
-/* TODO add support for RIGHT */
 /* TODO add [w]mem[r]{lower,upper}mem */
 
 
-/* The implementation of the algorithm, read
- * elsewhere for documentation/explanation. */
 {
-  ssize_t* next_map = alloca((needle_length + 1) * sizeof(ssize_t));
-  ssize_t hay, ned, skp;
+#ifndef COMPILED
+  CHTYPE a, b;
+  size_t suffix = 0, period = 0, maxsuf, p, i, j, k;
+  int pass, periodic;
+#else
+  size_t suffix = compiled->suffix, period = compiled->period, i, j;
+  int periodic = compiled->periodic;
+#endif
+  
+#ifndef COMPILE
+  if (!needle_length)
+    return FOUND(0);
+  
+#if !defined(CASE) && !defined(WIDE) && !defined(RIGHT)
+  if (needle_length == 1)
+    return DISPATCH(scan_memchr)(haystack, *needle, haystack_length);
+  if (needle_length <= SUBSTR_SHORT)
+    return DISPATCH(substr_memmem)(haystack, haystack_length, needle, needle_length);
+#elif !defined(CASE) && !defined(WIDE)
+  if (needle_length == 1)
+    return DISPATCH(scan_memrchr)(haystack, *needle, haystack_length);
+  if (needle_length <= SUBSTR_SHORT)
+    return DISPATCH(substr_memrmem)(haystack, haystack_length, needle, needle_length);
+#elif !defined(WIDE) && !defined(RIGHT)
+  if (needle_length == 1)
+    {
+      unsigned char lower = CHFOLD(*needle), upper = lower;
+      if ((lower >= 'a') && (lower <= 'z'))
+	upper = (unsigned char)(lower - ('a' - 'A'));
+      return DISPATCH(scan_memchr2)(haystack, lower, upper, haystack_length);
+    }
+  if (needle_length <= SUBSTR_SHORT)
+    return DISPATCH(substr_memcasemem)(haystack, haystack_length, needle, needle_length);
+#elif !defined(WIDE)
+  if ((needle_length > 1) && (needle_length <= SUBSTR_SHORT))
+    return DISPATCH(substr_memrcasemem)(haystack, haystack_length, needle, needle_length);
+#endif
+#endif
   
-  ned = 0, skp = next_map[0] = -1;
-  while (ned < (ssize_t)needle_length)
+#ifndef COMPILED
+  /* Find a critical factorisation of the needle, as the
+   * later of the maximal suffixes for the order of the
+   * characters and for its reverse, and the period of
+   * the right-hand side of the factorisation. */
+  for (pass = 0; pass < 2; pass++)
     {
-      while ((skp > -1) && !CHREQ(needle[ned], needle[skp]))
-	skp = next_map[skp];
-      ned++, skp++;
-      next_map[ned] = CHREQ(needle[ned], needle[skp]) ? next_map[skp] : skp;
+      maxsuf = SIZE_MAX, j = 0, k = p = 1;
+      while (j + k < needle_length)
+	{
+	  a = NEEDLE(j + k);
+	  b = NEEDLE(maxsuf + k);
+	  if (pass ? (b < a) : (a < b))
+	    j += k, k = 1, p = j - maxsuf;
+	  else if (a == b)
+	    {
+	      if (k != p)
+		k++;
+	      else
+		j += p, k = 1;
+	    }
+	  else
+	    maxsuf = j++, k = p = 1;
+	}
+      if (!pass || (maxsuf + 1 >= suffix))
+	suffix = maxsuf + 1, period = p;
     }
   
-  hay = ned = 0;
-  while (hay < (ssize_t)haystack_length)
+  /* Is the left-hand side of the factorisation a suffix
+   * of the right-hand side, so that the period is the
+   * period of the entire needle? */
+  for (i = 0; i < suffix; i++)
+    if (NEEDLE(i) != NEEDLE(i + period))
+      break;
+  periodic = i == suffix;
+#endif
+  
+#ifdef COMPILE
+  compiled->suffix = suffix;
+  compiled->period = period;
+  compiled->periodic = periodic;
+  return compiled;
+#else
+  if (periodic)
     {
-      while ((ned > -1) && !CHREQ(haystack[hay], needle[ned]))
-	ned = next_map[ned];
-      hay++, ned++;
-      if (ned >= (ssize_t)needle_length)
-	return needle + (hay - ned);
+      /* The needle is periodic. After a mismatch in the
+       * left-hand side, the part that was matched with the
+       * shift of one period is remembered, so it is not
+       * compared again. */
+      size_t memory;
+  
+      for (j = 0, memory = 0; j <= haystack_length - needle_length;)
+	{
+	  i = suffix > memory ? suffix : memory;
+	  while ((i < needle_length) && (NEEDLE(i) == HAYSTACK(i + j)))
+	    i++;
+	  if (i < needle_length)
+	    {
+	      j += i - suffix + 1, memory = 0;
+	      continue;
+	    }
+	  i = suffix;
+	  while ((i > memory) && (NEEDLE(i - 1) == HAYSTACK(i - 1 + j)))
+	    i--;
+	  if (i <= memory)
+	    return FOUND(j);
+	  j += period, memory = needle_length - period;
+	}
+    }
+  else
+    {
+      /* The needle is not periodic, the shift after a
+       * mismatch in the left-hand side is larger than
+       * any of its two sides. */
+      period = (suffix > needle_length - suffix ? suffix : needle_length - suffix) + 1;
+      for (j = 0; j <= haystack_length - needle_length;)
+	{
+	  i = suffix;
+	  while ((i < needle_length) && (NEEDLE(i) == HAYSTACK(i + j)))
+	    i++;
+	  if (i < needle_length)
+	    {
+	      j += i - suffix + 1;
+	      continue;
+	    }
+	  i = suffix;
+	  while (i && (NEEDLE(i - 1) == HAYSTACK(i - 1 + j)))
+	    i--;
+	  if (!i)
+	    return FOUND(j);
+	  j += period;
+	}
     }
   
   return NULL;
+#endif
 }
 
 
-#undef CHREQ
+#undef CHFOLD
+#undef CHTYPE
+#undef NEEDLE
+#undef HAYSTACK
+#undef FOUND
 
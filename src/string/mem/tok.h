@@ -0,0 +1,51 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines how the functions that tokenise
+ * memory segments find the set of delimiters in the
+ * private storage of a `struct memtok_state`. */
+
+
+#ifndef TOK_H
+#define TOK_H
+
+
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Get the set of delimiters in a `struct memtok_state`.
+ * 
+ * @param   state  The state, as a `struct memtok_state*`.
+ * @return         The set, as a `struct byteset*`.
+ */
+#define TOK_SET(state)  ((struct byteset*)(void*)((state)->__private))
+
+
+/**
+ * The private storage of `struct memtok_state` is
+ * large enough for a `struct byteset`, and aligned
+ * for it, this fails to compile otherwise.
+ */
+typedef char tok_size_check[((sizeof(((struct memtok_state*)0)->__private) >= sizeof(struct byteset)) &&
+			     (__alignof__(struct memtok_state) >= __alignof__(struct byteset))) ? 1 : -1];
+
+
+#endif
+
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "dispatch.h"
 
 
 
@@ -33,8 +34,7 @@
  */
 char* memfrob(char* segment, size_t size)
 {
-  while (--size)
-    segment[size] ^= 0x2A;
+  DISPATCH(transform_xorc)(segment, segment, 0x2A, size);
   return segment;
 }
 
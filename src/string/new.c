@@ -18,6 +18,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <ctype.h>
+#include "dispatch.h"
 /* TEMPORARY {{ */
 #define STATIC static __attribute__((__used__))
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -131,7 +132,7 @@ size_t strclen(const char* string, int stop)
  */
 size_t strcnlen(const char* string, int stop, size_t maxlen)
 {
-  const char* end = strnchr(string, stop, maxlen);
+  const char* end = DISPATCH(scan_strnchrnul2)(string, stop, stop, maxlen);
   return end ? (size_t)(end - string) : maxlen;
 }
 
@@ -191,11 +192,8 @@ size_t strstrnlen(const char* string, const char* stop, size_t maxlen)
  */
 char* (strnchr)(const char* string, int c, size_t maxlen)
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || !maxlen--)
-      return NULL;
+  const char* r = DISPATCH(scan_strnchrnul2)(string, c, c, maxlen);
+  return (r && (*r == (char)c)) ? r : NULL;
 }
 
 /**
@@ -218,11 +216,8 @@ char* (strnchr)(const char* string, int c, size_t maxlen)
  */
 char* (strnchrnul)(const char* string, int c, size_t maxlen)
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || !maxlen--)
-      return string;
+  const char* r = DISPATCH(scan_strnchrnul2)(string, c, c, maxlen);
+  return r ? r : string + maxlen;
 }
 
 /**
@@ -242,12 +237,8 @@ char* (strnchrnul)(const char* string, int c, size_t maxlen)
  */
 char* (memcchr)(const char* segment, int c, int stop, size_t size)
 {
-  char* s = segment;
-  for (;; s++)
-    if (*s == c)
-      return s;
-    else if ((*s == stop) || !size--)
-      return NULL;
+  const char* s = DISPATCH(scan_memchr2)(segment, c, stop, size);
+  return (s && (*s == (char)c)) ? s : NULL;
 }
 
 /**
@@ -268,11 +259,8 @@ char* (memcchr)(const char* segment, int c, int stop, size_t size)
  */
 char* (strcchr)(const char* string, int c, int stop)
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || (*string == stop))
-      return NULL;
+  const char* r = DISPATCH(scan_strchrnul2)(string, c, stop);
+  return *r == (char)c ? r : NULL;
 }
 
 /**
@@ -294,29 +282,19 @@ char* (strcchr)(const char* string, int c, int stop)
  */
 char* (strcnchr)(const char* string, int c, int stop, size_t maxlen)
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || (*string == stop) || !maxlen--)
-      return NULL;
+  const char* r = DISPATCH(scan_strnchrnul2)(string, c, stop, maxlen);
+  return (r && (*r == (char)c)) ? r : NULL;
 }
 
 char* (strcchrnul)(const char* string, int c, int stop) /* slibc+gnu: completeness */
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || (*string == stop))
-      return string;
+  return DISPATCH(scan_strchrnul2)(string, c, stop);
 }
 
 char* (strcnchrnul)(const char* string, int c, int stop, size_t maxlen) /* slibc+gnu: completeness */
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string || (*string == stop) || !maxlen--)
-      return string;
+  const char* r = DISPATCH(scan_strnchrnul2)(string, c, stop, maxlen);
+  return r ? r : string + maxlen;
 }
 
 char* (strnrchr)(const char* string, int c, size_t maxlen) /* slibc: completeness */
@@ -332,13 +310,11 @@ char* (strnrchr)(const char* string, int c, size_t maxlen) /* slibc: completenes
 
 void* (memcrchr)(const void* segment, int c, int stop, size_t size) /* slibc: completeness */
 {
-  char* r = NULL;
-  char* s = segment;
-  for (;; size--)
-    if (*s == c)
-      r = s;
-    else if ((*s == stop) || !size)
-      return r;
+  const char* s = segment;
+  const char* end = DISPATCH(scan_memchr)(s, stop, size);
+  if (end && (*end == (char)c))
+    return end;
+  return DISPATCH(scan_memrchr)(s, c, end ? (size_t)(end - s) : size);
 }
 
 char* (strcrchr)(const char* string, int c, int stop) /* slibc: completeness */
@@ -368,10 +344,7 @@ char* (strcnrchr)(const char* string, int c, int stop, size_t maxlen) /* slibc:
 
 void* (rawmemrchr)(const void* segment, int c, size_t size) /* slibc+gnu: completeness */
 {
-  char* s = segment;
-  for (;;)
-    if (s[--size] == c)
-      return s + size;
+  return DISPATCH(scan_rawmemrchr)((const char*)segment + size, c);
 }
 
 void* (rawmemcasemem)(const void* haystack, const void* needle, size_t needle_length) /* slibc */
@@ -418,128 +391,70 @@ char* (strcnstr)(const char* haystack, const char* needle, int stop, size_t maxl
 
 char* (strpcbrk)(const char* string, const char* skipset) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (set[(size_t)c])
-      break;
-  return c ? (s - 1) : NULL;
+  struct byteset set;
+  byteset_init(&set, skipset);
+  string = DISPATCH(byteset_scan)(string, &set, 1, SIZE_MAX);
+  return *string ? string : NULL;
 }
 
 char* (strpbrknul)(const char* string, const char* stopset) /* slibc */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (!set[(size_t)c])
-      break;
-  return s - 1;
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return DISPATCH(byteset_scan)(string, &set, 0, SIZE_MAX);
 }
 
 char* (strpcbrknul)(const char* string, const char* skipset) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (set[(size_t)c])
-      break;
-  return s - 1;
+  struct byteset set;
+  byteset_init(&set, skipset);
+  return DISPATCH(byteset_scan)(string, &set, 1, SIZE_MAX);
 }
 
 char* (strnpbrk)(const char* string, const char* stopset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (!set[(size_t)c])
-      break;
-  return c ? (s - 1) : NULL;
+  struct byteset set;
+  const char* r;
+  byteset_init(&set, stopset);
+  r = DISPATCH(byteset_scan)(string, &set, 0, maxlen);
+  return (((size_t)(r - string) < maxlen) && *r) ? r : NULL;
 }
 
 char* (strnpcbrk)(const char* string, const char* skipset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (set[(size_t)c])
-      break;
-  return c ? (s - 1) : NULL;
+  struct byteset set;
+  const char* r;
+  byteset_init(&set, skipset);
+  r = DISPATCH(byteset_scan)(string, &set, 1, maxlen);
+  return (((size_t)(r - string) < maxlen) && *r) ? r : NULL;
 }
 
 char* (strnpbrknul)(const char* string, const char* stopset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (!set[(size_t)c])
-      break;
-  return s - 1;
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return DISPATCH(byteset_scan)(string, &set, 0, maxlen);
 }
 
 char* (strnpcbrknul)(const char* string, const char* skipset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (set[(size_t)c])
-      break;
-  return s - 1;
+  struct byteset set;
+  byteset_init(&set, skipset);
+  return DISPATCH(byteset_scan)(string, &set, 1, maxlen);
 }
 
 size_t strnspn(const char* string, const char* skipset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256);
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  for (; maxlen && ((c = *s++)); maxlen--)
-    if (set[(size_t)c])
-      break;
-  return (size_t)(s - !!maxlen - string);
+  struct byteset set;
+  byteset_init(&set, skipset);
+  return (size_t)(DISPATCH(byteset_scan)(string, &set, 1, maxlen) - string);
 }
 
 size_t strncspn(const char* string, const char* stopset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256);
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  for (; maxlen && ((c = *s++)); maxlen--)
-    if (!set[(size_t)c])
-      break;
-  return (size_t)(s - !!maxlen - string);
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return (size_t)(DISPATCH(byteset_scan)(string, &set, 0, maxlen) - string);
 }
 
 char* strnsep(char** restrict string, const char* restrict delimiters,
@@ -562,7 +477,7 @@ char* strntok(char* restrict string, const char* restrict delimiters,
 	      char** restrict state, size_t* restrict maxlen) /* slibc: completeness */
 {
   char* r;
-  if (string == NULL)
+  if (string != NULL)
     *state = string;
   for (;;)
     {
@@ -576,62 +491,30 @@ char* strntok(char* restrict string, const char* restrict delimiters,
 
 char* (strprbrk)(const char* string, const char* stopset) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  const char* r = NULL;
-  memset(set, 0, 256);
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (!set[(size_t)c])
-      r = s - 1;
-  return r;
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return DISPATCH(byteset_rscan)(string, &set, 0, SIZE_MAX);
 }
 
 char* (strprcbrk)(const char* string, const char* skipset) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  const char* r = NULL;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (set[(size_t)c])
-      r = s - 1;
-  return r;
+  struct byteset set;
+  byteset_init(&set, skipset);
+  return DISPATCH(byteset_rscan)(string, &set, 1, SIZE_MAX);
 }
 
 char* (strnprbrk)(const char* string, const char* stopset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  const char* r = NULL;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (!set[(size_t)c])
-      r = s - 1;
-  return r;
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return DISPATCH(byteset_rscan)(string, &set, 0, maxlen);
 }
 
 char* (strnprcbrk)(const char* string, const char* skipset, size_t maxlen) /* slibc: completeness */
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  const char* r = NULL;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *skipset++))
-    set[(size_t)c] = 1;
-  while (maxlen-- && ((c = *s++)))
-    if (set[(size_t)c])
-      r = s - 1;
-  return r;
+  struct byteset set;
+  byteset_init(&set, skipset);
+  return DISPATCH(byteset_rscan)(string, &set, 1, maxlen);
 }
 
 char* memmemmove(char* whither, const char* whence, const char* restrict str,
@@ -885,67 +768,21 @@ int struppercmp(const char* a, const char* b) /* slibc: completeness */
 
 int strnlowercmp(const char* a, const char* b, size_t length) /* slibc: completeness */
 {
-  int c1, c2;
-  for (; length--; a++, b++)
-    if (*a != *b)
-      {
-	c1 = isalpha(*a) ? tolower(*a) : (int)*a;
-	c2 = *b;
-	if ((c1 -= c2))
-	  return c1;
-      }
-    else if (!*a && !*b)  return 0;
-    else if (!*a)         return -1;
-    else if (!*b)         return +1;
-  return 0;
+  return DISPATCH(compare_strncasecmp)((const unsigned char*)a, (const unsigned char*)b, length, COMPARE_LOWER);
 }
 
 int strnuppercmp(const char* a, const char* b, size_t length) /* slibc: completeness */
 {
-  int c1, c2;
-  for (; length--; a++, b++)
-    if (*a != *b)
-      {
-	c1 = isalpha(*a) ? toupper(*a) : (int)*a;
-	c2 = *b;
-	if ((c1 -= c2))
-	  return c1;
-      }
-    else if (!*a && !*b)  return 0;
-    else if (!*a)         return -1;
-    else if (!*b)         return +1;
-  return 0;
+  return DISPATCH(compare_strncasecmp)((const unsigned char*)a, (const unsigned char*)b, length, COMPARE_UPPER);
 }
 
 int memlowercmp(const void* a, const void* b, size_t size) /* slibc: completeness */
 {
-  const signed char* s1 = a;
-  const signed char* s2 = b;
-  int c1, c2;
-  for (; size--; s1++, s2++)
-    if (*s1 != *s2)
-      {
-	c1 = isalpha(*s1) ? tolower(*s1) : (int)*s1;
-	c2 = *s2;
-	if ((c1 -= c2))
-	  return c1;
-      }
-  return 0;
+  return DISPATCH(compare_memcasecmp)(a, b, size, COMPARE_LOWER);
 }
 
 int memuppercmp(const void* a, const void* b, size_t size) /* slibc: completeness */
 {
-  const signed char* s1 = a;
-  const signed char* s2 = b;
-  int c1, c2;
-  for (; size--; s1++, s2++)
-    if (*s1 != *s2)
-      {
-	c1 = isalpha(*s1) ? toupper(*s1) : (int)*s1;
-	c2 = *s2;
-	if ((c1 -= c2))
-	  return c1;
-      }
-  return 0;
+  return DISPATCH(compare_memcasecmp)(a, b, size, COMPARE_UPPER);
 }
 
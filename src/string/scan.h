@@ -0,0 +1,557 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h".
+ * It defines the kernels that search memory for bytes,
+ * for the instruction set selected in "simd.h". Each
+ * kernel is named with `SIMD`, so the file may be
+ * included once per instruction set. */
+
+
+
+/**
+ * Find the first occurrence of a byte in a memory segment.
+ * 
+ * @param   s     The memory segment.
+ * @param   c     The sought after byte.
+ * @param   size  The size of the memory segment.
+ * @return        The first occurrence of `c`, `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_memchr)(const char* s, int c, size_t size)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  size_t left = size + (size_t)(s - block);
+  simd_mask_t m, m1, m2, m3;
+  
+  if (!size)
+    return NULL;
+  if (left < size)
+    left = SIZE_MAX;
+  
+  /* `left` is the number of bytes from `block` to the
+   * end of the segment. The first block is masked so
+   * that bytes before `s` are ignored. */
+  m = SIMD_FROM(SIMD_EQ(SIMD_LOAD(block), needle), (size_t)(s - block));
+  if (m)
+    goto found;
+  
+  /* The unrolled loop reads four blocks at a time, these
+   * are aligned to four blocks so that they are in the
+   * same page. This makes it safe for the caller to pass
+   * a larger size than the segment actually has, as long
+   * as `c` is known to be found within the segment. */
+  while ((size_t)(block + SIMD_WIDTH) & (4 * SIMD_WIDTH - 1))
+    {
+      if (left <= SIMD_WIDTH)
+	return NULL;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      m = SIMD_EQ(SIMD_LOAD(block), needle);
+      if (m)
+	goto found;
+    }
+  
+  for (; left >= 5 * SIMD_WIDTH; left -= 4 * SIMD_WIDTH)
+    {
+      block += SIMD_WIDTH;
+      m  = SIMD_EQ(SIMD_LOAD(block + 0 * SIMD_WIDTH), needle);
+      m1 = SIMD_EQ(SIMD_LOAD(block + 1 * SIMD_WIDTH), needle);
+      m2 = SIMD_EQ(SIMD_LOAD(block + 2 * SIMD_WIDTH), needle);
+      m3 = SIMD_EQ(SIMD_LOAD(block + 3 * SIMD_WIDTH), needle);
+      if (m | m1 | m2 | m3)
+	{
+	  if (m)   return block + SIMD_FIRST(m);
+	  if (m1)  return block + 1 * SIMD_WIDTH + SIMD_FIRST(m1);
+	  if (m2)  return block + 2 * SIMD_WIDTH + SIMD_FIRST(m2);
+	  return          block + 3 * SIMD_WIDTH + SIMD_FIRST(m3);
+	}
+      block += 3 * SIMD_WIDTH;
+    }
+  
+  while (left > SIMD_WIDTH)
+    {
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      m = SIMD_EQ(SIMD_LOAD(block), needle);
+      if (m)
+	goto found;
+    }
+  return NULL;
+  
+ found:
+  return SIMD_FIRST(m) < left ? block + SIMD_FIRST(m) : NULL;
+}
+
+
+/**
+ * Find the first occurrence of either of two
+ * bytes in a memory segment.
+ * 
+ * @param   s     The memory segment.
+ * @param   c1    One of the sought after bytes.
+ * @param   c2    The other sought after byte.
+ * @param   size  The size of the memory segment.
+ * @return        The first occurrence of `c1` or `c2`,
+ *                `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_memchr2)(const char* s, int c1, int c2, size_t size)
+{
+  simd_t needle1 = SIMD_SPLAT(c1);
+  simd_t needle2 = SIMD_SPLAT(c2);
+  const char* block = SIMD_ALIGN(s);
+  size_t left = size + (size_t)(s - block);
+  simd_t v;
+  simd_mask_t m;
+  
+  if (!size)
+    return NULL;
+  if (left < size)
+    left = SIZE_MAX;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD_FROM(SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2), (size_t)(s - block));
+  while (!m)
+    {
+      if (left <= SIMD_WIDTH)
+	return NULL;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2);
+    }
+  return SIMD_FIRST(m) < left ? block + SIMD_FIRST(m) : NULL;
+}
+
+
+/**
+ * Find the first occurrence of a byte in memory,
+ * the byte must be known to exist.
+ * 
+ * @param   s  The memory segment.
+ * @param   c  The sought after byte.
+ * @return     The first occurrence of `c`.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_rawmemchr)(const char* s, int c)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  simd_mask_t m;
+  
+  m = SIMD_FROM(SIMD_EQ(SIMD_LOAD(block), needle), (size_t)(s - block));
+  while (!m)
+    {
+      block += SIMD_WIDTH;
+      m = SIMD_EQ(SIMD_LOAD(block), needle);
+    }
+  return block + SIMD_FIRST(m);
+}
+
+
+/**
+ * Find the last occurrence of a byte in a memory segment.
+ * 
+ * @param   s     The memory segment.
+ * @param   c     The sought after byte.
+ * @param   size  The size of the memory segment.
+ * @return        The last occurrence of `c`, `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_memrchr)(const char* s, int c, size_t size)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block;
+  size_t in_block;
+  simd_mask_t m;
+  
+  if (!size)
+    return NULL;
+  
+  /* `in_block` is the number of bytes in the current block
+   * that are in the segment, but only counting from the
+   * beginning of the block up to the last byte of the segment. */
+  block = SIMD_ALIGN(s + size - 1);
+  in_block = (size_t)(s + size - block);
+  m = SIMD_UPTO(SIMD_EQ(SIMD_LOAD(block), needle), in_block - 1);
+  
+  for (;;)
+    {
+      if (size <= in_block)
+	{
+	  m = SIMD_FROM(m, in_block - size);
+	  return m ? block + SIMD_LAST(m) : NULL;
+	}
+      if (m)
+	return block + SIMD_LAST(m);
+      size -= in_block, in_block = SIMD_WIDTH, block -= SIMD_WIDTH;
+      m = SIMD_EQ(SIMD_LOAD(block), needle);
+    }
+}
+
+
+/**
+ * Find the last occurrence of a byte in memory before
+ * a specified position, the byte must be known to exist.
+ * 
+ * @param   end  The end of the memory segment.
+ * @param   c    The sought after byte.
+ * @return       The last occurrence of `c` before `end`.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_rawmemrchr)(const char* end, int c)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(end - 1);
+  simd_mask_t m;
+  
+  m = SIMD_UPTO(SIMD_EQ(SIMD_LOAD(block), needle), (size_t)(end - 1 - block));
+  while (!m)
+    {
+      block -= SIMD_WIDTH;
+      m = SIMD_EQ(SIMD_LOAD(block), needle);
+    }
+  return block + SIMD_LAST(m);
+}
+
+
+/**
+ * Find the end of a NUL-terminated string.
+ * 
+ * @param   s  The string.
+ * @return     The terminating NUL byte of `s`.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_strlen)(const char* s)
+{
+  const char* block = SIMD_ALIGN(s);
+  simd_mask_t m;
+  
+  m = SIMD_FROM(SIMD_ZERO(SIMD_LOAD(block)), (size_t)(s - block));
+  while (!m)
+    {
+      block += SIMD_WIDTH;
+      m = SIMD_ZERO(SIMD_LOAD(block));
+    }
+  return block + SIMD_FIRST(m);
+}
+
+
+/**
+ * Find the end of a NUL-terminated string, but
+ * only inspect the beginning of the string.
+ * 
+ * @param   s       The string.
+ * @param   maxlen  The number of bytes to inspect, at most.
+ * @return          The number of bytes before the first NUL
+ *                  byte, `maxlen` if there is none.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+SIMD(scan_strnlen)(const char* s, size_t maxlen)
+{
+  const char* block = SIMD_ALIGN(s);
+  size_t left = maxlen + (size_t)(s - block);
+  simd_mask_t m;
+  
+  if (!maxlen)
+    return 0;
+  if (left < maxlen)
+    left = SIZE_MAX;
+  
+  m = SIMD_FROM(SIMD_ZERO(SIMD_LOAD(block)), (size_t)(s - block));
+  while (!m)
+    {
+      if (left <= SIMD_WIDTH)
+	return maxlen;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      m = SIMD_ZERO(SIMD_LOAD(block));
+    }
+  return SIMD_FIRST(m) < left ? (size_t)(block + SIMD_FIRST(m) - s) : maxlen;
+}
+
+
+/**
+ * Find the first occurrence of a byte in a
+ * string, or the end of the string.
+ * 
+ * @param   s  The string.
+ * @param   c  The sought after byte.
+ * @return     The first occurrence of `c`, or the
+ *             terminating NUL byte, whichever comes first.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_strchrnul)(const char* s, int c)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  simd_t v;
+  simd_mask_t m;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD_FROM(SIMD_EQ(v, needle) | SIMD_ZERO(v), (size_t)(s - block));
+  while (!m)
+    {
+      block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD_EQ(v, needle) | SIMD_ZERO(v);
+    }
+  return block + SIMD_FIRST(m);
+}
+
+
+/**
+ * Find the first occurrence of either of two bytes
+ * in a string, or the end of the string.
+ * 
+ * @param   s   The string.
+ * @param   c1  One of the sought after bytes.
+ * @param   c2  The other sought after byte.
+ * @return      The first occurrence of `c1` or `c2`, or the
+ *              terminating NUL byte, whichever comes first.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_strchrnul2)(const char* s, int c1, int c2)
+{
+  simd_t needle1 = SIMD_SPLAT(c1);
+  simd_t needle2 = SIMD_SPLAT(c2);
+  const char* block = SIMD_ALIGN(s);
+  simd_t v;
+  simd_mask_t m;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2) | SIMD_ZERO(v);
+  m = SIMD_FROM(m, (size_t)(s - block));
+  while (!m)
+    {
+      block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2) | SIMD_ZERO(v);
+    }
+  return block + SIMD_FIRST(m);
+}
+
+
+/**
+ * Find the first occurrence of either of two bytes
+ * in a string, or the end of the string, but only
+ * inspect the beginning of the string.
+ * 
+ * @param   s       The string.
+ * @param   c1      One of the sought after bytes.
+ * @param   c2      The other sought after byte.
+ * @param   maxlen  The number of bytes to inspect, at most.
+ * @return          The first occurrence of `c1` or `c2`, or the
+ *                  terminating NUL byte, whichever comes first.
+ *                  `NULL` if neither is found within `maxlen` bytes.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_strnchrnul2)(const char* s, int c1, int c2, size_t maxlen)
+{
+  simd_t needle1 = SIMD_SPLAT(c1);
+  simd_t needle2 = SIMD_SPLAT(c2);
+  const char* block = SIMD_ALIGN(s);
+  size_t left = maxlen + (size_t)(s - block);
+  simd_t v;
+  simd_mask_t m;
+  
+  if (!maxlen)
+    return NULL;
+  if (left < maxlen)
+    left = SIZE_MAX;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2) | SIMD_ZERO(v);
+  m = SIMD_FROM(m, (size_t)(s - block));
+  while (!m)
+    {
+      if (left <= SIMD_WIDTH)
+	return NULL;
+      left -= SIMD_WIDTH, block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD_EQ(v, needle1) | SIMD_EQ(v, needle2) | SIMD_ZERO(v);
+    }
+  return SIMD_FIRST(m) < left ? block + SIMD_FIRST(m) : NULL;
+}
+
+
+/**
+ * Find the last occurrence of a byte in a string.
+ * 
+ * @param   s  The string.
+ * @param   c  The sought after byte, may be NUL.
+ * @return     The last occurrence of `c`, `NULL` if none.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(scan_strrchr)(const char* s, int c)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  const char* last = NULL;
+  simd_t v;
+  simd_mask_t m, z;
+  
+  v = SIMD_LOAD(block);
+  m = SIMD_FROM(SIMD_EQ(v, needle), (size_t)(s - block));
+  z = SIMD_FROM(SIMD_ZERO(v), (size_t)(s - block));
+  while (!z)
+    {
+      if (m)
+	last = block + SIMD_LAST(m);
+      block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      m = SIMD_EQ(v, needle);
+      z = SIMD_ZERO(v);
+    }
+  m = SIMD_UPTO(m, SIMD_FIRST(z));
+  return m ? block + SIMD_LAST(m) : last;
+}
+
+
+/**
+ * The number of blocks that can be tallied in a block
+ * of counters, before the counters can overflow.
+ */
+#ifndef SCAN_TALLY_MAX
+# define SCAN_TALLY_MAX  255
+#endif
+
+
+/**
+ * Add up the counters in a block of counters.
+ * 
+ * @param   v  The block, see `SIMD_TALLY`.
+ * @return     The sum of the bytes in `v`.
+ */
+__attribute__((__const__, __unused__))
+static size_t
+SIMD(scan_sum)(simd_t v)
+{
+  union { simd_t v; unsigned char b[SIMD_WIDTH]; } u;
+  size_t i, n = 0;
+  
+  u.v = v;
+  for (i = 0; i < SIMD_WIDTH; i++)
+    n += u.b[i];
+  return n;
+}
+
+
+/**
+ * Count the occurrences of a byte in a memory segment.
+ * 
+ * The first and last blocks are counted with masks, the
+ * blocks between them are tallied in a block of counters,
+ * one per byte, that are added up every `SCAN_TALLY_MAX`
+ * blocks, so only one addition is made per block.
+ * 
+ * @param   s     The memory segment.
+ * @param   c     The sought after byte.
+ * @param   size  The size of the memory segment.
+ * @return        The number of occurrences of `c`.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+SIMD(scan_memcount)(const char* s, int c, size_t size)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  size_t left = size + (size_t)(s - block);
+  size_t n, blocks;
+  simd_mask_t m;
+  simd_t tally;
+  
+  if (!size)
+    return 0;
+  if (left < size)
+    left = SIZE_MAX;
+  
+  m = SIMD_FROM(SIMD_EQ(SIMD_LOAD(block), needle), (size_t)(s - block));
+  if (left <= SIMD_WIDTH)
+    return SIMD_COUNT(SIMD_UPTO(m, left - 1));
+  n = SIMD_COUNT(m);
+  block += SIMD_WIDTH;
+  left -= SIMD_WIDTH;
+  
+  while (left > SIMD_WIDTH)
+    {
+      blocks = (left - 1) / SIMD_WIDTH;
+      if (blocks > SCAN_TALLY_MAX)
+	blocks = SCAN_TALLY_MAX;
+      left -= blocks * SIMD_WIDTH;
+      tally = SIMD_SPLAT(0);
+      for (; blocks--; block += SIMD_WIDTH)
+	tally += SIMD_TALLY(SIMD_LOAD(block), needle);
+      n += SIMD(scan_sum)(tally);
+    }
+  
+  return n + SIMD_COUNT(SIMD_UPTO(SIMD_EQ(SIMD_LOAD(block), needle), left - 1));
+}
+
+
+/**
+ * Count the occurrences of a byte in a string.
+ * 
+ * @param   s  The string.
+ * @param   c  The sought after byte, must not be 0.
+ * @return     The number of occurrences of `c`.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+SIMD(scan_strcount)(const char* s, int c)
+{
+  simd_t needle = SIMD_SPLAT(c);
+  const char* block = SIMD_ALIGN(s);
+  size_t n, blocks = 0;
+  simd_t v, tally = SIMD_SPLAT(0);
+  simd_mask_t z;
+  
+  v = SIMD_LOAD(block);
+  z = SIMD_FROM(SIMD_ZERO(v), (size_t)(s - block));
+  if (z)
+    return SIMD_COUNT(SIMD_UPTO(SIMD_FROM(SIMD_EQ(v, needle), (size_t)(s - block)), SIMD_FIRST(z)));
+  n = SIMD_COUNT(SIMD_FROM(SIMD_EQ(v, needle), (size_t)(s - block)));
+  
+  for (;;)
+    {
+      block += SIMD_WIDTH;
+      v = SIMD_LOAD(block);
+      z = SIMD_ZERO(v);
+      if (z)
+	break;
+      tally += SIMD_TALLY(v, needle);
+      if (++blocks == SCAN_TALLY_MAX)
+	{
+	  n += SIMD(scan_sum)(tally);
+	  tally = SIMD_SPLAT(0);
+	  blocks = 0;
+	}
+    }
+  
+  n += SIMD(scan_sum)(tally);
+  return n + SIMD_COUNT(SIMD_UPTO(SIMD_EQ(v, needle), SIMD_FIRST(z)));
+}
+
@@ -0,0 +1,478 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included by functions that
+ * inspect memory a block at a time rather than a byte at
+ * a time. It defines the block type, and the macros that
+ * operate on it, for one instruction set: SIMD_ISA may be
+ * defined to SIMD_SWAR, SIMD_SSE2, SIMD_AVX2 or SIMD_AVX512
+ * before this file is included, otherwise the widest
+ * instruction set that the compiler targets is used. The
+ * file may be included again, with another SIMD_ISA, to
+ * replace the definitions.
+ * 
+ * A block is always loaded from an address aligned to its
+ * own width. Because a page is always a multiple of the
+ * width of a block, a block that contains one byte of an
+ * object never spans into another page than that byte, and
+ * cannot fault even if the rest of the block lies outside
+ * the object.
+ * 
+ * The result of a comparison is a mask, with one flag per
+ * byte in the block. Each flag is a single bit, but its
+ * position is unspecified, use the SIMD_FIRST, SIMD_LAST,
+ * SIMD_COUNT, SIMD_FROM, SIMD_UPTO, and SIMD_DROP macros
+ * to inspect and modify masks. */
+
+
+#ifndef SIMD_SWAR
+#include <stdint.h>
+
+
+
+/**
+ * Block at a time inspection using general purpose
+ * registers, without any vector instructions.
+ */
+#define SIMD_SWAR    1
+
+/**
+ * Block at a time inspection with SSE2 (16 bytes).
+ */
+#define SIMD_SSE2    2
+
+/**
+ * Block at a time inspection with AVX2 (32 bytes).
+ */
+#define SIMD_AVX2    3
+
+/**
+ * Block at a time inspection with AVX-512BW (64 bytes).
+ */
+#define SIMD_AVX512  4
+
+
+/**
+ * The general purpose register used as a block
+ * when no vector instructions are used.
+ */
+typedef unsigned long int simd_word_t __attribute__((__may_alias__));
+
+/**
+ * `simd_word_t` without alignment requirement.
+ */
+typedef unsigned long int simd_uword_t __attribute__((__may_alias__, __aligned__(1)));
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * 16-byte vector, used by SSE2.
+ */
+typedef char simd_v16_t __attribute__((__vector_size__(16), __may_alias__, __aligned__(16)));
+
+/**
+ * 32-byte vector, used by AVX2.
+ */
+typedef char simd_v32_t __attribute__((__vector_size__(32), __may_alias__, __aligned__(32)));
+
+/**
+ * 64-byte vector, used by AVX-512BW.
+ */
+typedef char simd_v64_t __attribute__((__vector_size__(64), __may_alias__, __aligned__(64)));
+
+/**
+ * `simd_v16_t` without alignment requirement.
+ */
+typedef char simd_v16u_t __attribute__((__vector_size__(16), __may_alias__, __aligned__(1)));
+
+/**
+ * `simd_v32_t` without alignment requirement.
+ */
+typedef char simd_v32u_t __attribute__((__vector_size__(32), __may_alias__, __aligned__(1)));
+
+/**
+ * `simd_v64_t` without alignment requirement.
+ */
+typedef char simd_v64u_t __attribute__((__vector_size__(64), __may_alias__, __aligned__(1)));
+
+/**
+ * `simd_v16_t` as 16-bit words.
+ */
+typedef unsigned short int simd_v16w_t __attribute__((__vector_size__(16), __may_alias__));
+
+/**
+ * `simd_v16_t` as 32-bit doublewords.
+ */
+typedef unsigned int simd_v16d_t __attribute__((__vector_size__(16), __may_alias__));
+
+/**
+ * `simd_v16_t` as 64-bit quadwords.
+ */
+typedef unsigned long long int simd_v16q_t __attribute__((__vector_size__(16), __may_alias__));
+#endif
+
+
+/**
+ * `simd_word_t` with 0x01 in each byte.
+ */
+#define SIMD_ONES  ((simd_word_t)~0UL / 0xFF)
+
+/**
+ * `simd_word_t` with 0x7F in each byte.
+ */
+#define SIMD_LOWS  (SIMD_ONES * 0x7F)
+
+/**
+ * Create a mask, for a `simd_word_t`, with the highest
+ * bit in each byte set if and only if the byte is zero.
+ * Unlike the common `(x - ONES) & ~x & HIGHS`, this is
+ * exact for every byte, not just the first zero byte.
+ * 
+ * @param   x  The word.
+ * @return     The mask.
+ */
+#define SIMD_WORD_ZEROS(x)  (~((((x) & SIMD_LOWS) + SIMD_LOWS) | (x) | SIMD_LOWS))
+
+
+/**
+ * Swap the adjacent bytes, in a `simd_word_t`.
+ */
+#define SIMD_WORD_SWAP8(x)  ((((x) >> 8) & ((simd_word_t)~0UL / 0xFFFFU * 0xFFU)) |	\
+			     (((x) & ((simd_word_t)~0UL / 0xFFFFU * 0xFFU)) << 8))
+
+/**
+ * Swap the adjacent 16-bit words, in a `simd_word_t`.
+ */
+#define SIMD_WORD_SWAP16(x)  ((((x) >> 16) & ((simd_word_t)~0UL / 0xFFFFFFFFUL * 0xFFFFU)) |	\
+			      (((x) & ((simd_word_t)~0UL / 0xFFFFFFFFUL * 0xFFFFU)) << 16))
+
+
+/**
+ * Round a pointer down to the beginning of the block
+ * it points into.
+ * 
+ * @param   p  The pointer.
+ * @return     The beginning of the block, as a `const char*`.
+ */
+#define SIMD_ALIGN(p)  ((const char*)((size_t)(p) & ~(size_t)(SIMD_WIDTH - 1)))
+
+
+/**
+ * The smallest page size of any supported system.
+ */
+#define SIMD_PAGESIZE  4096
+
+/**
+ * Check whether an unaligned block can be loaded
+ * from an address without spanning two pages.
+ * 
+ * @param   p  The address of the block.
+ * @return     Whether the block is within one page.
+ */
+#define SIMD_LOADU_SAFE(p)  (((size_t)(p) & (SIMD_PAGESIZE - 1)) <= SIMD_PAGESIZE - SIMD_WIDTH)
+
+
+#endif
+
+
+
+#ifndef SIMD_ISA
+# if defined(__AVX512BW__)
+#  define SIMD_ISA  SIMD_AVX512
+# elif defined(__AVX2__)
+#  define SIMD_ISA  SIMD_AVX2
+# elif defined(__SSE2__)
+#  define SIMD_ISA  SIMD_SSE2
+# else
+#  define SIMD_ISA  SIMD_SWAR
+# endif
+#endif
+
+
+/* For the selected instruction set, the following are defined:
+ * 
+ *   SIMD_WIDTH          The number of bytes in a block.
+ *   simd_t              The type of a block.
+ *   simd_mask_t         The type of a mask.
+ *   SIMD(name)          `name` suffixed with the name of the
+ *                       instruction set, used to name kernels
+ *                       so that they can be compiled for
+ *                       multiple instruction sets.
+ *   SIMD_LOAD(p)        Load the block at `p`, which must be
+ *                       aligned to `SIMD_WIDTH`.
+ *   SIMD_LOADU(p)       Load the block at `p`, which need not
+ *                       be aligned. The whole block must be
+ *                       readable, see `SIMD_LOADU_SAFE`.
+ *   SIMD_STORE(p, v)    Store the block `v` at `p`, which must
+ *                       be aligned to `SIMD_WIDTH`.
+ *   SIMD_STOREU(p, v)   Store the block `v` at `p`, which need
+ *                       not be aligned.
+ *   SIMD_SPLAT(c)       Create a block where each byte is `c`.
+ *   SIMD_EQ(a, b)       Mask of the bytes where `a` and `b`
+ *                       are equal.
+ *   SIMD_NE(a, b)       Mask of the bytes where `a` and `b`
+ *                       differ.
+ *   SIMD_ZERO(a)        Mask of the bytes in `a` that are zero.
+ *   SIMD_TALLY(a, b)    Block with 1 in the bytes where `a`
+ *                       and `b` are equal, and 0 elsewhere,
+ *                       it can be added to a block of counters.
+ *   SIMD_ALL            Mask with the flags of all bytes set.
+ *   SIMD_FIRST(m)       The index of the first flagged byte,
+ *                       `m` must not be zero.
+ *   SIMD_LAST(m)        The index of the last flagged byte,
+ *                       `m` must not be zero.
+ *   SIMD_FROM(m, k)     `m` without the flags of the bytes
+ *                       before index `k` (`k` < `SIMD_WIDTH`).
+ *   SIMD_UPTO(m, k)     `m` without the flags of the bytes
+ *                       after index `k` (`k` < `SIMD_WIDTH`).
+ *   SIMD_DROP(m)        `m` without the flag of its first
+ *                       flagged byte, `m` must not be zero.
+ *   SIMD_LOWER(v)       `v` with ASCII letters in lowercase.
+ *   SIMD_UPPER(v)       `v` with ASCII letters in uppercase.
+ *   SIMD_REVERSE(v, w)  `v` with the order of its `w`-byte
+ *                       elements reversed, `w` must be a
+ *                       constant power of two, at most 8
+ *                       and at most `SIMD_WIDTH`.
+ * 
+ * If the instruction set can shuffle bytes, SIMD_SHUFFLE
+ * is also defined:
+ * 
+ *   SIMD_SHUFFLE(t, i)  Block where each byte is the byte in
+ *                       `t` whose index, within the same 16
+ *                       bytes, is the low nibble of the byte
+ *                       in `i`, or zero if the highest bit of
+ *                       the byte in `i` is set. */
+
+#undef SIMD_WIDTH
+#undef simd_t
+#undef simd_mask_t
+#undef SIMD
+#undef SIMD_LOAD
+#undef SIMD_LOADU
+#undef SIMD_STORE
+#undef SIMD_STOREU
+#undef SIMD_SPLAT
+#undef SIMD_EQ
+#undef SIMD_NE
+#undef SIMD_ZERO
+#undef SIMD_TALLY
+#undef SIMD_ALL
+#undef SIMD_CTZ
+#undef SIMD_CLZ
+#undef SIMD_POPCOUNT
+#undef SIMD_FIRST
+#undef SIMD_LAST
+#undef SIMD_COUNT
+#undef SIMD_FROM
+#undef SIMD_UPTO
+#undef SIMD_DROP
+#undef SIMD_LOWER
+#undef SIMD_UPPER
+#undef SIMD_REVERSE
+#undef SIMD_BSWAP
+#undef SIMD_IOTA
+#undef SIMD_REVERSE_D
+#undef SIMD_SWAP_D
+#undef SIMD_SWAP_W
+#undef SIMD_SHUFFLE
+
+
+#if SIMD_ISA == SIMD_SWAR
+
+# define SIMD_WIDTH          __SIZEOF_LONG__
+# define simd_t              simd_word_t
+# define simd_mask_t         unsigned long int
+# define SIMD(name)          name##_swar
+# define SIMD_LOAD(p)        (*(const simd_word_t*)(p))
+# define SIMD_LOADU(p)       (*(const simd_uword_t*)(p))
+# define SIMD_STORE(p, v)    (*(simd_word_t*)(p) = (v))
+# define SIMD_STOREU(p, v)   (*(simd_uword_t*)(p) = (v))
+# define SIMD_SPLAT(c)       ((simd_word_t)(unsigned char)(c) * SIMD_ONES)
+# define SIMD_EQ(a, b)       SIMD_WORD_ZEROS((a) ^ (b))
+# define SIMD_ZERO(a)        SIMD_WORD_ZEROS(a)
+# define SIMD_TALLY(a, b)    (SIMD_EQ(a, b) >> 7)
+# if __SIZEOF_LONG__ == 8
+#  define SIMD_BSWAP(v)      ((simd_word_t)__builtin_bswap64(v))
+# else
+#  define SIMD_BSWAP(v)      ((simd_word_t)__builtin_bswap32(v))
+# endif
+/* Reversing all bytes also reverses the bytes in each
+ * element, which is undone by swapping them back. */
+# define SIMD_REVERSE(v, w)						\
+  ((w) == 1 ? SIMD_BSWAP(v) :						\
+   (w) == 2 ? SIMD_WORD_SWAP8(SIMD_BSWAP(v)) :				\
+   (w) == 4 ? SIMD_WORD_SWAP16(SIMD_WORD_SWAP8(SIMD_BSWAP(v))) : (v))
+# define SIMD_ALL            (SIMD_ONES << 7)
+# define SIMD_CTZ(m)         ((size_t)__builtin_ctzl(m))
+# define SIMD_CLZ(m)         ((size_t)__builtin_clzl(m))
+# define SIMD_POPCOUNT(m)    ((size_t)__builtin_popcountl(m))
+# if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define SIMD_FIRST(m)      (SIMD_CTZ(m) / 8)
+#  define SIMD_LAST(m)       ((8 * SIMD_WIDTH - 1 - SIMD_CLZ(m)) / 8)
+#  define SIMD_FROM(m, k)    ((m) & (~0UL << (8 * (k))))
+#  define SIMD_UPTO(m, k)    ((m) & (~0UL >> (8 * (SIMD_WIDTH - 1 - (k)))))
+#  define SIMD_DROP(m)       ((m) & ((m) - 1))
+# else
+#  define SIMD_FIRST(m)      (SIMD_CLZ(m) / 8)
+#  define SIMD_LAST(m)       ((8 * SIMD_WIDTH - 1 - SIMD_CTZ(m)) / 8)
+#  define SIMD_FROM(m, k)    ((m) & (~0UL >> (8 * (k))))
+#  define SIMD_UPTO(m, k)    ((m) & (~0UL << (8 * (SIMD_WIDTH - 1 - (k)))))
+#  define SIMD_DROP(m)       ((m) ^ ((~0UL ^ (~0UL >> 1)) >> SIMD_CLZ(m)))
+# endif
+
+#elif SIMD_ISA == SIMD_SSE2
+
+# define SIMD_WIDTH          16
+# define simd_t              simd_v16_t
+# define simd_mask_t         unsigned int
+# define SIMD(name)          name##_sse2
+# define SIMD_LOAD(p)        (*(const simd_v16_t*)(p))
+# define SIMD_LOADU(p)       ((simd_v16_t)*(const simd_v16u_t*)(p))
+# define SIMD_STORE(p, v)    (*(simd_v16_t*)(p) = (v))
+# define SIMD_STOREU(p, v)   (*(simd_v16u_t*)(p) = (v))
+# define SIMD_SPLAT(c)       ((simd_v16_t){ 0 } + (char)(c))
+# define SIMD_EQ(a, b)       ((simd_mask_t)__builtin_ia32_pmovmskb128((simd_v16_t)((a) == (b))))
+# define SIMD_ZERO(a)        SIMD_EQ(a, ((simd_v16_t){ 0 }))
+# define SIMD_TALLY(a, b)    ((simd_v16_t)-((a) == (b)))
+/* SSE2 cannot shuffle bytes, so the order of the doublewords
+ * is reversed, and then the order of the words and bytes
+ * in them, with shifts. */
+# define SIMD_REVERSE(v, w)						\
+  ((w) == 8 ? (simd_v16_t)__builtin_shuffle((simd_v16q_t)(v), (simd_v16q_t){ 1, 0 }) :		\
+   (w) == 4 ? (simd_v16_t)SIMD_REVERSE_D(v) :						\
+   (w) == 2 ? (simd_v16_t)SIMD_SWAP_D(SIMD_REVERSE_D(v)) :				\
+   (simd_v16_t)SIMD_SWAP_W((simd_v16w_t)SIMD_SWAP_D(SIMD_REVERSE_D(v))))
+# define SIMD_REVERSE_D(v)  __builtin_shuffle((simd_v16d_t)(v), (simd_v16d_t){ 3, 2, 1, 0 })
+# define SIMD_SWAP_D(d)     (((d) << 16) | ((d) >> 16))
+# define SIMD_SWAP_W(x)     (((x) << 8) | ((x) >> 8))
+# define SIMD_ALL            0xFFFFU
+
+#elif SIMD_ISA == SIMD_AVX2
+
+# define SIMD_WIDTH          32
+# define simd_t              simd_v32_t
+# define simd_mask_t         unsigned int
+# define SIMD(name)          name##_avx2
+# define SIMD_LOAD(p)        (*(const simd_v32_t*)(p))
+# define SIMD_LOADU(p)       ((simd_v32_t)*(const simd_v32u_t*)(p))
+# define SIMD_STORE(p, v)    (*(simd_v32_t*)(p) = (v))
+# define SIMD_STOREU(p, v)   (*(simd_v32u_t*)(p) = (v))
+# define SIMD_SPLAT(c)       ((simd_v32_t){ 0 } + (char)(c))
+# define SIMD_EQ(a, b)       ((simd_mask_t)__builtin_ia32_pmovmskb256((simd_v32_t)((a) == (b))))
+# define SIMD_ZERO(a)        SIMD_EQ(a, ((simd_v32_t){ 0 }))
+# define SIMD_TALLY(a, b)    ((simd_v32_t)-((a) == (b)))
+# define SIMD_IOTA							\
+  ((simd_v32_t){ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,	\
+		 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 })
+# define SIMD_ALL            0xFFFFFFFFU
+# define SIMD_SHUFFLE(t, i)  ((simd_v32_t)__builtin_ia32_pshufb256((t), (i)))
+
+#elif SIMD_ISA == SIMD_AVX512
+
+# define SIMD_WIDTH          64
+# define simd_t              simd_v64_t
+# define simd_mask_t         unsigned long long int
+# define SIMD(name)          name##_avx512
+# define SIMD_LOAD(p)        (*(const simd_v64_t*)(p))
+# define SIMD_LOADU(p)       ((simd_v64_t)*(const simd_v64u_t*)(p))
+# define SIMD_STORE(p, v)    (*(simd_v64_t*)(p) = (v))
+# define SIMD_STOREU(p, v)   (*(simd_v64u_t*)(p) = (v))
+# define SIMD_SPLAT(c)       ((simd_v64_t){ 0 } + (char)(c))
+# define SIMD_EQ(a, b)       ((simd_mask_t)__builtin_ia32_pcmpeqb512_mask((a), (b), ~0ULL))
+# define SIMD_ZERO(a)        SIMD_EQ(a, ((simd_v64_t){ 0 }))
+# define SIMD_TALLY(a, b)    ((simd_v64_t)-((a) == (b)))
+# define SIMD_IOTA							\
+  ((simd_v64_t){ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,	\
+		 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,	\
+		 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,	\
+		 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63 })
+# define SIMD_ALL            (~0ULL)
+# define SIMD_SHUFFLE(t, i)  ((simd_v64_t)__builtin_ia32_pshufb512_mask((t), (i), ((simd_v64_t){ 0 }), ~0ULL))
+
+#else
+# error "SIMD_ISA is not a supported instruction set."
+#endif
+
+
+#if SIMD_ISA != SIMD_SWAR
+/* On x86, a mask has the flag of byte i at bit i. */
+# if SIMD_ISA == SIMD_AVX512
+#  define SIMD_CTZ(m)        ((size_t)__builtin_ctzll(m))
+#  define SIMD_CLZ(m)        ((size_t)__builtin_clzll(m))
+#  define SIMD_POPCOUNT(m)   ((size_t)__builtin_popcountll(m))
+# else
+#  define SIMD_CTZ(m)        ((size_t)__builtin_ctz(m))
+#  define SIMD_CLZ(m)        ((size_t)__builtin_clz(m))
+#  define SIMD_POPCOUNT(m)   ((size_t)__builtin_popcount(m))
+# endif
+# define SIMD_FIRST(m)       SIMD_CTZ(m)
+# define SIMD_LAST(m)        (8 * sizeof(simd_mask_t) - 1 - SIMD_CLZ(m))
+# define SIMD_FROM(m, k)     ((m) & ((simd_mask_t)~(simd_mask_t)0 << (k)))
+# define SIMD_UPTO(m, k)     ((m) & ((simd_mask_t)~(simd_mask_t)0 >> (8 * sizeof(simd_mask_t) - 1 - (k))))
+# define SIMD_DROP(m)        ((m) & ((m) - 1))
+#endif
+
+
+/**
+ * Convert the ASCII uppercase letters in
+ * a block to lowercase.
+ */
+#if SIMD_ISA == SIMD_SWAR
+/* The highest bit of each byte in the low seven bits plus
+ * 0x80 - 'A' is set iff the byte is at least 'A', and in
+ * the low seven bits plus 0x7F - 'Z' iff it is above 'Z'. */
+# define SIMD_LOWER(v)							\
+  ((v) | ((((((v) & SIMD_LOWS) + SIMD_ONES * (0x80 - 'A')) ^		\
+	    (((v) & SIMD_LOWS) + SIMD_ONES * (0x7F - 'Z'))) & ~(v) & SIMD_ALL) >> 2))
+#else
+/* 'A' through 'Z' are moved to the bottom of the
+ * signed range, so that one comparison suffices. */
+# define SIMD_LOWER(v)							\
+  ((v) | ((simd_t)((simd_t)((v) + (char)(0x80 - 'A')) < (char)(26 - 0x80)) & (char)0x20))
+#endif
+
+/**
+ * Convert the ASCII lowercase letters in
+ * a block to uppercase.
+ */
+#if SIMD_ISA == SIMD_SWAR
+/* See `SIMD_LOWER`. */
+# define SIMD_UPPER(v)							\
+  ((v) ^ ((((((v) & SIMD_LOWS) + SIMD_ONES * (0x80 - 'a')) ^		\
+	    (((v) & SIMD_LOWS) + SIMD_ONES * (0x7F - 'z'))) & ~(v) & SIMD_ALL) >> 2))
+#else
+# define SIMD_UPPER(v)							\
+  ((v) ^ ((simd_t)((simd_t)((v) + (char)(0x80 - 'a')) < (char)(26 - 0x80)) & (char)0x20))
+#endif
+
+#ifdef SIMD_IOTA
+/* Byte `i` of the result is byte `W - w - i + 2 (i mod w)`. */
+# define SIMD_REVERSE(v, w)						\
+  ((simd_t)__builtin_shuffle((v), (simd_t)((char)(SIMD_WIDTH - (w)) - SIMD_IOTA +	\
+					  (char)2 * (SIMD_IOTA & (char)((w) - 1)))))
+#endif
+
+/**
+ * The number of set flags in a mask, that is,
+ * the number of bytes that matched.
+ */
+#define SIMD_COUNT(m)  SIMD_POPCOUNT(m)
+
+/**
+ * Mask of the bytes where two blocks differ.
+ */
+#define SIMD_NE(a, b)  (SIMD_EQ(a, b) ^ SIMD_ALL)
+
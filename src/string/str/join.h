@@ -0,0 +1,87 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file defines the function that `strjoin` and
+ * `vstrcat` share. */
+
+
+#ifndef JOIN_H
+#define JOIN_H
+
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <slibc/internals.h>
+
+
+
+/**
+ * Concatenate strings, with a separator between
+ * each of them, into a newly allocated string.
+ * 
+ * The strings are measured before the allocation,
+ * so that exactly one allocation is made.
+ * 
+ * @param   sep    The separator, `NULL` for none.
+ * @param   first  The first string, `NULL` for none.
+ * @param   args   The rest of the strings, terminated by `NULL`.
+ * @return         The new string. `NULL` is returned on error
+ *                 and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ */
+__attribute__((__unused__))
+static char*
+strjoin_va(const char* sep, const char* first, va_list args)
+{
+  size_t seplen = sep == NULL ? 0 : strlen(sep);
+  size_t total = 0, count = 0, size;
+  int overflow = 0;
+  const char* s;
+  va_list measure;
+  char* r;
+  char* p;
+  
+  va_copy(measure, args);
+  for (s = first; s != NULL; s = va_arg(measure, const char*), count++)
+    overflow |= __builtin_uaddl_overflow(total, strlen(s), &total);
+  va_end(measure);
+  if (overflow)
+    return errno = ENOMEM, NULL;
+  
+  MEM_OVERFLOW(umull, count ? count - 1 : 0, seplen, &size);
+  MEM_OVERFLOW(uaddl, total, size, &total);
+  MEM_OVERFLOW(uaddl, total, 1, &total);
+  p = r = malloc(total * sizeof(char));
+  if (r == NULL)
+    return NULL;
+  
+  *p = 0;
+  for (s = first, count = 0; s != NULL; s = va_arg(args, const char*))
+    {
+      if (count++)
+	p = mempcpy(p, sep, seplen);
+      p = stpcpy(p, s);
+    }
+  return r;
+}
+
+
+#endif
+
@@ -16,7 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
-#include <stdint.h>
+#include "../dispatch.h"
 
 
 
@@ -36,6 +36,6 @@
  */
 int strcasecmp(const char* a, const char* b)
 {
-  return strncasecmp(a, b, SIZE_MAX);
+  return DISPATCH(compare_strncasecmp)((const unsigned char*)a, (const unsigned char*)b, SIZE_MAX, COMPARE_CASE);
 }
 
@@ -16,6 +16,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
 
 
 
@@ -32,6 +36,13 @@
  */
 char* (strcasestr)(const char* haystack, const char* needle)
 {
-  return (memcasemem)(haystack, strlen(haystack), needle, strlen(needle));
+  size_t n = strlen(needle);
+  if (!n)
+    return haystack;
+  if (strnlen(haystack, n) < n)
+    return NULL;
+  if ((n > 1) && (n <= SUBSTR_SHORT))
+    return DISPATCH(substr_strcasestr)(haystack, needle, n);
+  return (memcasemem)(haystack, strlen(haystack), needle, n);
 }
 
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -39,9 +40,9 @@
  */
 char* strccpy(char* restrict whither, const char* restrict whence, int c)
 {
-  char* r = memccpy(whither, whence, c, strlen(whence) + 1);
-  if (r)
-    *r = 0;
-  return r;
+  const char* stop = DISPATCH(copy_strccpy)(whither, whence, c, SIZE_MAX);
+  size_t n = (size_t)(stop - whence);
+  whither[n] = 0;
+  return *stop == (char)c ? (whither + n) : NULL;
 }
 
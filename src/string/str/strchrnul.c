@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -40,10 +41,6 @@
  */
 char* (strchrnul)(const char* string, int c)
 {
-  for (;; string++)
-    if (*string == c)
-      return string;
-    else if (!*string)
-      return string;
+  return DISPATCH(scan_strchrnul)(string, c);
 }
 
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -39,7 +40,19 @@
  */
 char* strcmove(char* whither, const char* whence, int c)
 {
-  char* r = memcmove(whither, whence, c, strlen(whence) + 1);
+  const char* stop;
+  char* r;
+  size_t n;
+  if (whither <= whence)
+    {
+      /* Copying forwards is safe. */
+      stop = DISPATCH(copy_strccpy)(whither, whence, c, SIZE_MAX);
+      n = (size_t)(stop - whence);
+      r = *stop == (char)c ? (whither + n) : NULL;
+      whither[n] = 0;
+      return r;
+    }
+  r = memcmove(whither, whence, c, strlen(whence) + 1);
   if (r)
     *r = 0;
   return r;
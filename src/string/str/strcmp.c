@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -31,8 +32,6 @@
  */
 int strcmp(const char* a, const char* b)
 {
-  size_t n = strlen(a);
-  size_t m = strlen(b);
-  return memcmp(a, b, (n < m ? n : m) + 1);
+  return DISPATCH(compare_strncmp)((const unsigned char*)a, (const unsigned char*)b, SIZE_MAX);
 }
 
@@ -0,0 +1,39 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Count the occurrences of a byte in a string.
+ * 
+ * @param   str  The string.
+ * @param   c    The sought after byte.
+ * @return       The number of occurrences of `c`, the
+ *               terminating NUL byte is not counted.
+ * 
+ * @since  Always.
+ */
+size_t strcount(const char* str, int c)
+{
+  if (!(char)c)
+    return 0;
+  return DISPATCH(scan_strcount)(str, c);
+}
+
@@ -16,6 +16,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include <stdint.h>
+#include "../dispatch.h"
 
 
 
@@ -32,15 +34,8 @@
  */
 size_t strcspn(const char* string, const char* stopset)
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256);
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (!set[(size_t)c])
-      break;
-  return (size_t)(s - 1 - string);
+  struct byteset set;
+  byteset_init(&set, stopset);
+  return (size_t)(DISPATCH(byteset_scan)(string, &set, 0, SIZE_MAX) - string);
 }
 
@@ -0,0 +1,43 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+
+
+/**
+ * Get the canonical copy of a string. Equal strings
+ * have the same canonical copy, so interned strings
+ * can be compared by their addresses.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   string  The string.
+ * @return          The canonical copy of `string`, it is
+ *                  valid until the process exits. `NULL`
+ *                  is returned on error and `errno` is
+ *                  set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+const char* strintern(const char* string)
+{
+  return memintern(string, strlen(string));
+}
+
@@ -0,0 +1,64 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdlib.h>
+#include <slibc/internals.h>
+
+
+
+/**
+ * Concatenate an array of strings, with a separator
+ * between each of them, into a newly allocated string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   sep      The separator, `NULL` for none.
+ * @param   strings  The strings.
+ * @param   count    The number of elements in `strings`.
+ * @return           The new string. `NULL` is returned on error
+ *                   and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+char* strjoinv(const char* sep, const char* const* strings, size_t count)
+{
+  size_t seplen = sep == NULL ? 0 : strlen(sep);
+  size_t total = 1, i;
+  char* r;
+  char* p;
+  
+  for (i = 0; i < count; i++)
+    MEM_OVERFLOW(uaddl, total, strlen(strings[i]), &total);
+  MEM_OVERFLOW(umull, count ? count - 1 : 0, seplen, &i);
+  MEM_OVERFLOW(uaddl, total, i, &total);
+  p = r = malloc(total * sizeof(char));
+  if (r == NULL)
+    return NULL;
+  
+  *p = 0;
+  for (i = 0; i < count; i++)
+    {
+      if (i)
+	p = mempcpy(p, sep, seplen);
+      p = stpcpy(p, strings[i]);
+    }
+  return r;
+}
+
@@ -16,6 +16,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include <stdint.h>
+#include "../dispatch.h"
 
 
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -38,15 +40,9 @@
  */
 char* (strpbrk)(const char* string, const char* stopset)
 {
-  char set[256];
-  char c;
-  const char* s = string;
-  memset(set, 0, 256 * sizeof(char));
-  while ((c = *stopset++))
-    set[(size_t)c] = 1;
-  while ((c = *s++))
-    if (!set[(size_t)c])
-      break;
-  return c ? (s - 1) : NULL;
+  struct byteset set;
+  byteset_init(&set, stopset);
+  string = DISPATCH(byteset_scan)(string, &set, 0, SIZE_MAX);
+  return *string ? string : NULL;
 }
 
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 # pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
@@ -40,11 +41,6 @@
  */
 char* (strrchr)(const char* string, int c)
 {
-  char* r = NULL;
-  for (;;)
-    if (*string == c)
-      r = string;
-    else if (!*string++)
-      return c ? r : (string - 1);
+  return DISPATCH(scan_strrchr)(string, c);
 }
 
@@ -16,6 +16,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
 
 
 
@@ -32,8 +36,13 @@
  */
 char* (strstr)(const char* haystack, const char* needle)
 {
-  if (*needle && !(needle[1]))
-    return (strchr)(haystack, *needle);
-  return (memmem)(haystack, strlen(haystack), needle, strlen(needle));
+  size_t n = strlen(needle);
+  if (n <= 1)
+    return n ? (strchr)(haystack, *needle) : haystack;
+  if (strnlen(haystack, n) < n)
+    return NULL;
+  if (n <= SUBSTR_SHORT)
+    return DISPATCH(substr_strstr)(haystack, needle, n);
+  return (memmem)(haystack, strlen(haystack), needle, n);
 }
 
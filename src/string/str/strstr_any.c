@@ -0,0 +1,46 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+
+
+/**
+ * Find the first occurrence of any of a set of substrings.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   haystack  The string to search.
+ * @param   needles   `NULL`-terminated list of the sought after substrings.
+ * @param   which     Output parameter for the index of the found
+ *                    substring, may be `NULL`, see `memmem_multi_exec`.
+ * @return            The first position in `haystack` where any of
+ *                    the substrings occur, `NULL` if none or on
+ *                    error, in which case `errno` is set.
+ * 
+ * @throws  ENOMEM  The process cannot allocate more memory.
+ * 
+ * @since  Always.
+ */
+char* (strstr_any)(const char* haystack, const char* const* needles, size_t* which)
+{
+  size_t count = 0;
+  while (needles[count] != NULL)
+    count++;
+  return (memmem_multi)(haystack, strlen(haystack), (const void* const*)needles, NULL, count, which);
+}
+
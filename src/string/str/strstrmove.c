@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -39,9 +40,30 @@
  */
 char* strstrmove(char* whither, const char* whence, const char* restrict str)
 {
-  const char* stop = str == NULL ? NULL : strstr(whence, str);
-  size_t n = stop == NULL ? strlen(whence) : (size_t)(stop - whence);
-  char* r = stop == NULL ? NULL : (whither + n);
+  size_t m = str == NULL ? 0 : strnlen(str, SUBSTR_SHORT + 1);
+  const char* stop;
+  size_t n = 0;
+  char* r;
+  
+  if ((m > 0) && (m <= SUBSTR_SHORT) && (whither <= whence))
+    {
+      /* See `strstrcpy`. */
+      for (;;)
+	{
+	  stop = DISPATCH(copy_strccpy)(whither + n, whence + n, *str, SIZE_MAX);
+	  n = (size_t)(stop - whence);
+	  if (!*stop || !strncmp(stop, str, m))
+	    break;
+	  whither[n++] = *stop;
+	}
+      r = *stop ? (whither + n) : NULL;
+      whither[n] = 0;
+      return r;
+    }
+  
+  stop = str == NULL ? NULL : strstr(whence, str);
+  n = stop == NULL ? strlen(whence) : (size_t)(stop - whence);
+  r = stop == NULL ? NULL : (whither + n);
   memmove(whither, whence, n);
   whither[n] = 0;
   return r;
@@ -39,8 +39,6 @@
 char* strtok(char* restrict string, const char* restrict delimiters)
 {
   static char* state = NULL;
-  if (string == NULL)
-    state = NULL;
   return strtok_r(string, delimiters, &state);
 }
 
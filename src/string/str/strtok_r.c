@@ -16,6 +16,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include <stdint.h>
+#include "../dispatch.h"
+
+
+# pragma GCC diagnostic ignored "-Wdiscarded-qualifiers"
 
 
 
@@ -43,16 +48,23 @@
 char* strtok_r(char* restrict string, const char* restrict delimiters,
 	       char** restrict state)
 {
+  struct byteset set;
   char* r;
-  if (string == NULL)
+  char* end;
+  if (string != NULL)
     *state = string;
-  for (;;)
-    {
-      r = strsep(state, delimiters);
-      if (r == NULL)
-	return NULL;
-      if (*r)
-	return r;
-    }
+  if (*state == NULL)
+    return NULL;
+  
+  byteset_init(&set, delimiters);
+  r = DISPATCH(byteset_scan)(*state, &set, 1, SIZE_MAX);
+  if (!*r)
+    return *state = NULL;
+  
+  end = DISPATCH(byteset_scan)(r, &set, 0, SIZE_MAX);
+  *state = *end ? end + 1 : NULL;
+  *end = 0;
+  
+  return r;
 }
 
@@ -0,0 +1,39 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+
+
+
+/**
+ * Copy a string, but convert all
+ * ASCII letters to uppercase.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   dest  The destination string, may be `src`,
+ *                but may not otherwise overlap with it.
+ * @param   src   The source string.
+ * @return        `dest` is returned.
+ * 
+ * @since  Always.
+ */
+char* strupper(char* dest, const char* src)
+{
+  return memupper(dest, src, strlen(src) + 1);
+}
+
@@ -0,0 +1,47 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <stdarg.h>
+#include "join.h"
+
+
+
+/**
+ * Concatenate strings into a newly allocated string.
+ * 
+ * This is a slibc extension.
+ * 
+ * @param   first  The first string, `NULL` for none.
+ * @param   ...    The rest of the strings, terminated by `NULL`.
+ * @return         The new string. `NULL` is returned on error
+ *                 and `errno` is set to indicate the error.
+ * 
+ * @throws  ENOMEM  The process could not allocate sufficient amount of memory.
+ * 
+ * @since  Always.
+ */
+char* vstrcat(const char* first, ...)
+{
+  va_list args;
+  char* r;
+  va_start(args, first);
+  r = strjoin_va(NULL, first, args);
+  va_end(args);
+  return r;
+}
+
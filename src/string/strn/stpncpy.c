@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -40,8 +41,7 @@
  */
 char* stpncpy(char* restrict whither, const char* restrict whence, size_t maxlen)
 {
-  size_t n = strnlen(whence, maxlen);
-  memcpy(whither, whence, n);
+  size_t n = (size_t)(DISPATCH(copy_strccpy)(whither, whence, 0, maxlen) - whence);
   memset(whither + n, 0, maxlen - n);
   return whither + n;
 }
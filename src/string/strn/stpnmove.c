@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -41,8 +42,11 @@
  */
 char* stpnmove(char* whither, const char* whence, size_t maxlen)
 {
-  size_t n = strnlen(whence, maxlen);
-  memmove(whither, whence, n);
+  size_t n;
+  if (whither <= whence)
+    n = (size_t)(DISPATCH(copy_strccpy)(whither, whence, 0, maxlen) - whence);
+  else
+    n = strnlen(whence, maxlen), memmove(whither, whence, n);
   memset(whither + n, 0, maxlen - n);
   return whither + n;
 }
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -46,10 +47,9 @@
  */
 char* strcncpy(char* restrict whither, const char* restrict whence, int c, size_t maxlen)
 {
-  const char* stop = memchr(whence, c, maxlen);
-  size_t n = stop == NULL ? strnlen(whence, maxlen) : (size_t)(stop - whence);
-  char* r = stop == NULL ? NULL : (whither + n);
-  memcpy(whither, whence, n);
+  const char* stop = DISPATCH(copy_strccpy)(whither, whence, c, maxlen);
+  size_t n = (size_t)(stop - whence);
+  char* r = ((n < maxlen) && (*stop == (char)c)) ? (whither + n) : NULL;
   memset(whither + n, 0, maxlen - n);
   return r;
 }
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -46,10 +47,24 @@
  */
 char* strcnmove(char* whither, const char* whence, int c, size_t maxlen)
 {
-  const char* stop = memchr(whence, c, maxlen);
-  size_t n = stop == NULL ? strnlen(whence, maxlen) : (size_t)(stop - whence);
-  char* r = stop == NULL ? NULL : (whither + n);
-  memmove(whither, whence, n);
+  const char* stop;
+  size_t n;
+  char* r;
+  if (whither <= whence)
+    {
+      /* Copying forwards is safe. */
+      stop = DISPATCH(copy_strccpy)(whither, whence, c, maxlen);
+      n = (size_t)(stop - whence);
+      r = ((n < maxlen) && (*stop == (char)c)) ? (whither + n) : NULL;
+    }
+  else
+    {
+      n = strnlen(whence, maxlen);
+      stop = memchr(whence, c, n < maxlen ? n + 1 : n);
+      n = stop == NULL ? n : (size_t)(stop - whence);
+      r = stop == NULL ? NULL : (whither + n);
+      memmove(whither, whence, n);
+    }
   memset(whither + n, 0, maxlen - n);
   return r;
 }
@@ -16,7 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
-#include <ctype.h>
+#include "../dispatch.h"
 
 
 
@@ -37,18 +37,6 @@
  */
 int strncasecmp(const char* a, const char* b, size_t length)
 {
-  int c1, c2;
-  for (; length--; a++, b++)
-    if (*a != *b)
-      {
-	c1 = isalpha(*a) ? tolower(*a) : (int)*a;
-	c2 = isalpha(*b) ? tolower(*b) : (int)*b;
-	if ((c1 -= c2))
-	  return c1;
-      }
-    else if (!*a && !*b)  return 0;
-    else if (!*a)         return -1;
-    else if (!*b)         return +1;
-  return 0;
+  return DISPATCH(compare_strncasecmp)((const unsigned char*)a, (const unsigned char*)b, length, COMPARE_CASE);
 }
 
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -32,9 +33,6 @@
  */
 int strncmp(const char* a, const char* b, size_t length)
 {
-  size_t n = strnlen(a, length);
-  size_t m = strnlen(b, length);
-  int r = memcmp(a, b, (n < m ? n : m));
-  return r ? r : n == m ? 0 : n < m ? -1 : +1;
+  return DISPATCH(compare_strncmp)((const unsigned char*)a, (const unsigned char*)b, length);
 }
 
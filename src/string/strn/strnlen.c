@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string.h>
+#include "../dispatch.h"
 
 
 
@@ -32,7 +33,6 @@
  */
 size_t strnlen(const char* str, size_t maxlen)
 {
-  const char* end = memchr(str, 0, maxlen);
-  return end == NULL ? maxlen : (size_t)(end - str);
+  return DISPATCH(scan_strnlen)(str, maxlen);
 }
 
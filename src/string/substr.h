@@ -0,0 +1,429 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h",
+ * "compare.h", and "hwcaps.h". It defines the kernels that search
+ * for short substrings, for the instruction set selected
+ * in "simd.h". Each kernel is named with `SIMD`, so the
+ * file may be included once per instruction set.
+ * 
+ * A position in the haystack is a candidate if both the
+ * first and the last byte of the needle are found where
+ * they would be if the needle started at that position.
+ * Candidates are found a block at a time, by comparing
+ * a block loaded at the position with the first byte
+ * and a block loaded `needle_length - 1` bytes later
+ * with the last byte, and are then verified. This is
+ * quadratic in the worst case, and is therefore only
+ * used for needles no longer than `SUBSTR_SHORT`, longer
+ * needles are searched with the Two-Way algorithm in
+ * "mem/substring.h". The case-insensitive kernels fold
+ * each loaded block to lowercase before comparing it;
+ * the needle is folded when the blocks of its first
+ * and last bytes are created.
+ * 
+ * The haystack may be longer than it is known to be
+ * readable: when its length is given as `SIZE_MAX`,
+ * only the bytes up to the end of the first occurrence
+ * are readable. A block is therefore only loaded if it
+ * does not span two pages, otherwise the positions in
+ * it are inspected a byte at a time. */
+
+
+#ifndef SUBSTR_H_COMMON
+#define SUBSTR_H_COMMON
+
+
+/**
+ * The longest needle that shall be searched for
+ * using the kernels in "substr.h".
+ */
+#define SUBSTR_SHORT  32
+
+
+/**
+ * Fold a byte to lowercase, using `__slibc_fold`.
+ * 
+ * @param   c  The byte, as a `char`.
+ * @return     The byte in lowercase, as an `unsigned char`.
+ */
+#define SUBSTR_FOLD(c)  (__slibc_fold[(unsigned char)(c)])
+
+
+#endif
+
+
+
+/**
+ * Find the first occurrence of a short substring
+ * in a memory segment.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`, at least `needle_length`.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`, at least 2.
+ * @return                   The first occurrence of `needle`,
+ *                           `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_memmem)(const char* haystack, size_t haystack_length,
+		    const char* needle, size_t needle_length)
+{
+  const size_t positions = haystack_length - needle_length + 1;
+  const size_t last = needle_length - 1;
+  const simd_t vfirst = SIMD_SPLAT(needle[0]);
+  const simd_t vlast = SIMD_SPLAT(needle[last]);
+  simd_mask_t m;
+  size_t i = 0, j, end;
+  
+  while (i < positions)
+    {
+      if ((positions - i >= SIMD_WIDTH) && SIMD_LOADU_SAFE(haystack + i + last))
+	{
+	  m  = SIMD_EQ(SIMD_LOADU(haystack + i), vfirst);
+	  m &= SIMD_EQ(SIMD_LOADU(haystack + i + last), vlast);
+	  for (; m; m = SIMD_DROP(m))
+	    {
+	      j = i + SIMD_FIRST(m);
+	      if (!SIMD(compare_bcmp)((const unsigned char*)haystack + j + 1,
+				      (const unsigned char*)needle + 1, last - 1))
+		return haystack + j;
+	    }
+	  i += SIMD_WIDTH;
+	}
+      else
+	{
+	  /* Positions are tried in order, so no byte after
+	   * the end of the first occurrence is read. */
+	  end = positions - i < SIMD_WIDTH ? positions : i + SIMD_WIDTH;
+	  for (; i < end; i++)
+	    if ((haystack[i] == needle[0]) && (haystack[i + last] == needle[last]) &&
+		!SIMD(compare_bcmp)((const unsigned char*)haystack + i + 1,
+				    (const unsigned char*)needle + 1, last - 1))
+	      return haystack + i;
+	}
+    }
+  
+  return NULL;
+}
+
+
+/**
+ * Find the first occurrence of a short substring
+ * in a string.
+ * 
+ * @param   haystack       The string to search, its first `needle_length`
+ *                         bytes must not be NUL.
+ * @param   needle         The sought after substring.
+ * @param   needle_length  The length of `needle`, at least 2.
+ * @return                 The first occurrence of `needle`,
+ *                         `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_strstr)(const char* haystack, const char* needle, size_t needle_length)
+{
+  const size_t last = needle_length - 1;
+  const simd_t vfirst = SIMD_SPLAT(needle[0]);
+  const simd_t vlast = SIMD_SPLAT(needle[last]);
+  simd_t v;
+  simd_mask_t m, z;
+  size_t i = 0, j;
+  char c;
+  
+  /* Only the block of last bytes needs to be checked for
+   * the end of the string: every byte before it has been
+   * checked already. For the same reason, if the first
+   * byte of that block is readable, so is the block of
+   * first bytes, which ends no later. */
+  for (;;)
+    {
+      if (SIMD_LOADU_SAFE(haystack + i + last))
+	{
+	  v = SIMD_LOADU(haystack + i + last);
+	  z = SIMD_ZERO(v);
+	  m = SIMD_EQ(v, vlast) & SIMD_EQ(SIMD_LOADU(haystack + i), vfirst);
+	  if (z)
+	    {
+	      j = SIMD_FIRST(z);
+	      m = j ? SIMD_UPTO(m, j - 1) : 0;
+	    }
+	  for (; m; m = SIMD_DROP(m))
+	    {
+	      j = i + SIMD_FIRST(m);
+	      if (!SIMD(compare_bcmp)((const unsigned char*)haystack + j + 1,
+				      (const unsigned char*)needle + 1, last - 1))
+		return haystack + j;
+	    }
+	  if (z)
+	    return NULL;
+	  i += SIMD_WIDTH;
+	}
+      else
+	for (j = i + SIMD_WIDTH; i < j; i++)
+	  {
+	    c = haystack[i + last];
+	    if (!c)
+	      return NULL;
+	    if ((c == needle[last]) && (haystack[i] == needle[0]) &&
+		!SIMD(compare_bcmp)((const unsigned char*)haystack + i + 1,
+				    (const unsigned char*)needle + 1, last - 1))
+	      return haystack + i;
+	  }
+    }
+}
+
+
+
+/**
+ * Check whether two memory segments differ,
+ * when case is ignored.
+ * 
+ * @param   a     One of the memory segments.
+ * @param   b     The other memory segment.
+ * @param   size  The size of the segments.
+ * @return        0 if the segments are equal,
+ *                a non-zero value otherwise.
+ */
+__attribute__((__pure__, __unused__))
+static int
+SIMD(substr_casediff)(const char* a, const char* b, size_t size)
+{
+  size_t i = 0;
+  
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    if (SIMD_NE(SIMD_LOWER(SIMD_LOADU(a + i)), SIMD_LOWER(SIMD_LOADU(b + i))))
+      return 1;
+  for (; i < size; i++)
+    if (SUBSTR_FOLD(a[i]) != SUBSTR_FOLD(b[i]))
+      return 1;
+  return 0;
+}
+
+
+/**
+ * Find the first occurrence of a short substring
+ * in a memory segment, ignoring case.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`, at least `needle_length`.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`, at least 2.
+ * @return                   The first occurrence of `needle`,
+ *                           `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_memcasemem)(const char* haystack, size_t haystack_length,
+			const char* needle, size_t needle_length)
+{
+  const size_t positions = haystack_length - needle_length + 1;
+  const size_t last = needle_length - 1;
+  const unsigned char first_c = SUBSTR_FOLD(needle[0]);
+  const unsigned char last_c = SUBSTR_FOLD(needle[last]);
+  const simd_t vfirst = SIMD_SPLAT(first_c);
+  const simd_t vlast = SIMD_SPLAT(last_c);
+  simd_mask_t m;
+  size_t i = 0, j, end;
+  
+  while (i < positions)
+    {
+      if ((positions - i >= SIMD_WIDTH) && SIMD_LOADU_SAFE(haystack + i + last))
+	{
+	  m  = SIMD_EQ(SIMD_LOWER(SIMD_LOADU(haystack + i)), vfirst);
+	  m &= SIMD_EQ(SIMD_LOWER(SIMD_LOADU(haystack + i + last)), vlast);
+	  for (; m; m = SIMD_DROP(m))
+	    {
+	      j = i + SIMD_FIRST(m);
+	      if (!SIMD(substr_casediff)(haystack + j + 1, needle + 1, last - 1))
+		return haystack + j;
+	    }
+	  i += SIMD_WIDTH;
+	}
+      else
+	{
+	  end = positions - i < SIMD_WIDTH ? positions : i + SIMD_WIDTH;
+	  for (; i < end; i++)
+	    if ((SUBSTR_FOLD(haystack[i]) == first_c) && (SUBSTR_FOLD(haystack[i + last]) == last_c) &&
+		!SIMD(substr_casediff)(haystack + i + 1, needle + 1, last - 1))
+	      return haystack + i;
+	}
+    }
+  
+  return NULL;
+}
+
+
+/**
+ * Find the first occurrence of a short substring
+ * in a string, ignoring case.
+ * 
+ * @param   haystack       The string to search, its first `needle_length`
+ *                         bytes must not be NUL.
+ * @param   needle         The sought after substring.
+ * @param   needle_length  The length of `needle`, at least 2.
+ * @return                 The first occurrence of `needle`,
+ *                         `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_strcasestr)(const char* haystack, const char* needle, size_t needle_length)
+{
+  const size_t last = needle_length - 1;
+  const unsigned char first_c = SUBSTR_FOLD(needle[0]);
+  const unsigned char last_c = SUBSTR_FOLD(needle[last]);
+  const simd_t vfirst = SIMD_SPLAT(first_c);
+  const simd_t vlast = SIMD_SPLAT(last_c);
+  simd_t v;
+  simd_mask_t m, z;
+  size_t i = 0, j;
+  char c;
+  
+  /* See `substr_strstr`. */
+  for (;;)
+    {
+      if (SIMD_LOADU_SAFE(haystack + i + last))
+	{
+	  v = SIMD_LOADU(haystack + i + last);
+	  z = SIMD_ZERO(v);
+	  m = SIMD_EQ(SIMD_LOWER(v), vlast) & SIMD_EQ(SIMD_LOWER(SIMD_LOADU(haystack + i)), vfirst);
+	  if (z)
+	    {
+	      j = SIMD_FIRST(z);
+	      m = j ? SIMD_UPTO(m, j - 1) : 0;
+	    }
+	  for (; m; m = SIMD_DROP(m))
+	    {
+	      j = i + SIMD_FIRST(m);
+	      if (!SIMD(substr_casediff)(haystack + j + 1, needle + 1, last - 1))
+		return haystack + j;
+	    }
+	  if (z)
+	    return NULL;
+	  i += SIMD_WIDTH;
+	}
+      else
+	for (j = i + SIMD_WIDTH; i < j; i++)
+	  {
+	    c = haystack[i + last];
+	    if (!c)
+	      return NULL;
+	    if ((SUBSTR_FOLD(c) == last_c) && (SUBSTR_FOLD(haystack[i]) == first_c) &&
+		!SIMD(substr_casediff)(haystack + i + 1, needle + 1, last - 1))
+	      return haystack + i;
+	  }
+    }
+}
+
+
+/**
+ * Find the last occurrence of a short substring
+ * in a memory segment.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`, at least `needle_length`.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`, at least 2.
+ * @return                   The last occurrence of `needle`,
+ *                           `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_memrmem)(const char* haystack, size_t haystack_length,
+		     const char* needle, size_t needle_length)
+{
+  const size_t last = needle_length - 1;
+  const simd_t vfirst = SIMD_SPLAT(needle[0]);
+  const simd_t vlast = SIMD_SPLAT(needle[last]);
+  simd_mask_t m;
+  size_t i = haystack_length - last, j;
+  
+  /* The length of the haystack is known, so blocks are
+   * loaded without regard to pages, from the end. The
+   * positions before the first whole block are tried
+   * a byte at a time. */
+  while (i >= SIMD_WIDTH)
+    {
+      i -= SIMD_WIDTH;
+      m  = SIMD_EQ(SIMD_LOADU(haystack + i), vfirst);
+      m &= SIMD_EQ(SIMD_LOADU(haystack + i + last), vlast);
+      while (m)
+	{
+	  j = SIMD_LAST(m);
+	  if (!SIMD(compare_bcmp)((const unsigned char*)haystack + i + j + 1,
+				  (const unsigned char*)needle + 1, last - 1))
+	    return haystack + i + j;
+	  m = j ? SIMD_UPTO(m, j - 1) : 0;
+	}
+    }
+  while (i--)
+    if ((haystack[i] == needle[0]) && (haystack[i + last] == needle[last]) &&
+	!SIMD(compare_bcmp)((const unsigned char*)haystack + i + 1,
+			    (const unsigned char*)needle + 1, last - 1))
+      return haystack + i;
+  
+  return NULL;
+}
+
+
+/**
+ * Find the last occurrence of a short substring
+ * in a memory segment, ignoring case.
+ * 
+ * @param   haystack         The memory segment to search.
+ * @param   haystack_length  The size of `haystack`, at least `needle_length`.
+ * @param   needle           The sought after substring.
+ * @param   needle_length    The length of `needle`, at least 2.
+ * @return                   The last occurrence of `needle`,
+ *                           `NULL` if none were found.
+ */
+__attribute__((__pure__, __unused__))
+static const char*
+SIMD(substr_memrcasemem)(const char* haystack, size_t haystack_length,
+			 const char* needle, size_t needle_length)
+{
+  const size_t last = needle_length - 1;
+  const unsigned char first_c = SUBSTR_FOLD(needle[0]);
+  const unsigned char last_c = SUBSTR_FOLD(needle[last]);
+  const simd_t vfirst = SIMD_SPLAT(first_c);
+  const simd_t vlast = SIMD_SPLAT(last_c);
+  simd_mask_t m;
+  size_t i = haystack_length - last, j;
+  
+  /* See `substr_memrmem`. */
+  while (i >= SIMD_WIDTH)
+    {
+      i -= SIMD_WIDTH;
+      m  = SIMD_EQ(SIMD_LOWER(SIMD_LOADU(haystack + i)), vfirst);
+      m &= SIMD_EQ(SIMD_LOWER(SIMD_LOADU(haystack + i + last)), vlast);
+      while (m)
+	{
+	  j = SIMD_LAST(m);
+	  if (!SIMD(substr_casediff)(haystack + i + j + 1, needle + 1, last - 1))
+	    return haystack + i + j;
+	  m = j ? SIMD_UPTO(m, j - 1) : 0;
+	}
+    }
+  while (i--)
+    if ((SUBSTR_FOLD(haystack[i]) == first_c) && (SUBSTR_FOLD(haystack[i + last]) == last_c) &&
+	!SIMD(substr_casediff)(haystack + i + 1, needle + 1, last - 1))
+      return haystack + i;
+  
+  return NULL;
+}
+
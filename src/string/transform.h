@@ -0,0 +1,240 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h".
+ * It defines the kernels that transform each byte in a
+ * memory segment, for the instruction set selected in
+ * "simd.h". Each kernel is named with `SIMD`, so the
+ * file may be included once per instruction set.
+ * 
+ * The kernels write the transformed bytes of a source
+ * segment to a destination segment, which may be the
+ * source segment itself, but may not otherwise overlap
+ * with it. Blocks are stored as in "copy.h": aligned,
+ * with the unaligned beginning and end written last,
+ * with one unaligned block each. Both of these blocks
+ * are transformed before anything is stored, so when
+ * the transformation is done in place, every byte is
+ * transformed from its original value, even if it is
+ * stored twice. */
+
+
+#ifndef TRANSFORM_H_COMMON
+#define TRANSFORM_H_COMMON
+
+
+/**
+ * XOR a memory segment with another
+ * memory segment a word at a time.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  k     The segment to XOR `s` with.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+transform_short_xor(char* d, const char* s, const char* k, size_t size)
+{
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    *(simd_uword_t*)(d + i) = *(const simd_uword_t*)(s + i) ^ *(const simd_uword_t*)(k + i);
+  for (; i < size; i++)
+    d[i] = (char)(s[i] ^ k[i]);
+}
+
+
+/**
+ * XOR each byte in a memory segment
+ * with a byte a word at a time.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  c     The byte to XOR each byte with.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+transform_short_xorc(char* d, const char* s, int c, size_t size)
+{
+  simd_word_t w = (simd_word_t)(unsigned char)c * SIMD_ONES;
+  size_t i = 0;
+  
+  for (; i + sizeof(simd_word_t) <= size; i += sizeof(simd_word_t))
+    *(simd_uword_t*)(d + i) = *(const simd_uword_t*)(s + i) ^ w;
+  for (; i < size; i++)
+    d[i] = (char)(s[i] ^ c);
+}
+
+
+/**
+ * Convert the ASCII letters in a memory
+ * segment to lowercase or uppercase.
+ * 
+ * @param  d      The destination, may be `s`.
+ * @param  s      The source.
+ * @param  size   The size of the segments.
+ * @param  upper  Whether the letters shall be converted
+ *                to uppercase rather than to lowercase.
+ */
+__attribute__((__unused__))
+static void
+transform_short_case(char* d, const char* s, size_t size, int upper)
+{
+  unsigned char c;
+  size_t i;
+  
+  for (i = 0; i < size; i++)
+    {
+      c = (unsigned char)s[i];
+      if ((unsigned)(c - (upper ? 'a' : 'A')) < 26)
+	c ^= 0x20;
+      d[i] = (char)c;
+    }
+}
+
+
+#endif
+
+
+
+/**
+ * XOR a memory segment with another memory segment.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  k     The segment to XOR `s` with, it may
+ *               only overlap with `d` if it is `d`.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+SIMD(transform_xor)(char* d, const char* s, const char* k, size_t size)
+{
+  simd_t head, tail;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      transform_short_xor(d, s, k, size);
+      return;
+    }
+  
+  head = SIMD_LOADU(s) ^ SIMD_LOADU(k);
+  tail = SIMD_LOADU(s + size - SIMD_WIDTH) ^ SIMD_LOADU(k + size - SIMD_WIDTH);
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    SIMD_STORE(d + i, SIMD_LOADU(s + i) ^ SIMD_LOADU(k + i));
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
+
+/**
+ * XOR each byte in a memory segment with a byte.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  c     The byte to XOR each byte with.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+SIMD(transform_xorc)(char* d, const char* s, int c, size_t size)
+{
+  simd_t v, head, tail;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      transform_short_xorc(d, s, c, size);
+      return;
+    }
+  
+  v = SIMD_SPLAT(c);
+  head = SIMD_LOADU(s) ^ v;
+  tail = SIMD_LOADU(s + size - SIMD_WIDTH) ^ v;
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    SIMD_STORE(d + i, SIMD_LOADU(s + i) ^ v);
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
+
+/**
+ * Convert the ASCII letters in a memory segment to lowercase.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+SIMD(transform_lower)(char* d, const char* s, size_t size)
+{
+  simd_t v, head, tail;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      transform_short_case(d, s, size, 0);
+      return;
+    }
+  
+  v = SIMD_LOADU(s), head = SIMD_LOWER(v);
+  v = SIMD_LOADU(s + size - SIMD_WIDTH), tail = SIMD_LOWER(v);
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    {
+      v = SIMD_LOADU(s + i);
+      SIMD_STORE(d + i, SIMD_LOWER(v));
+    }
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
+
+/**
+ * Convert the ASCII letters in a memory segment to uppercase.
+ * 
+ * @param  d     The destination, may be `s`.
+ * @param  s     The source.
+ * @param  size  The size of the segments.
+ */
+__attribute__((__unused__))
+static void
+SIMD(transform_upper)(char* d, const char* s, size_t size)
+{
+  simd_t v, head, tail;
+  size_t i;
+  
+  if (size < SIMD_WIDTH)
+    {
+      transform_short_case(d, s, size, 1);
+      return;
+    }
+  
+  v = SIMD_LOADU(s), head = SIMD_UPPER(v);
+  v = SIMD_LOADU(s + size - SIMD_WIDTH), tail = SIMD_UPPER(v);
+  for (i = SIMD_WIDTH - ((size_t)d & (SIMD_WIDTH - 1)); i + SIMD_WIDTH <= size; i += SIMD_WIDTH)
+    {
+      v = SIMD_LOADU(s + i);
+      SIMD_STORE(d + i, SIMD_UPPER(v));
+    }
+  SIMD_STOREU(d, head);
+  SIMD_STOREU(d + size - SIMD_WIDTH, tail);
+}
+
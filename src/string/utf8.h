@@ -0,0 +1,308 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* This file is intended to be included after "simd.h"
+ * and "scan.h". It defines the kernels that validate
+ * UTF-8 and count its characters, for the instruction
+ * set selected in "simd.h". Each kernel is named with `SIMD`, so the
+ * file may be included once per instruction set.
+ * 
+ * Blocks that only contain ASCII are skipped after
+ * testing their highest bits. Other blocks are validated
+ * a block at a time if the instruction set can shuffle
+ * bytes, using the lookup method by Keiser and Lemire:
+ * the high nibble of each byte, and both nibbles of the
+ * byte before it, select, from three 16-byte tables,
+ * the errors that the pair of bytes could be part of,
+ * and an error is reported when all three agree, except
+ * that a continuation byte must follow a lead byte two
+ * or three bytes earlier iff it is the third or fourth
+ * byte of the sequence. Otherwise, blocks are validated
+ * a character at a time. In either case, the exact
+ * position of the first error is found a character at
+ * a time, starting at most four bytes before the block
+ * in which the error was detected.
+ * 
+ * Blocks are validated from unaligned addresses, because
+ * the bytes before each block are needed as well, and
+ * the size of the input is known. Characters are counted
+ * in aligned blocks, as in "scan.h". */
+
+
+#ifndef UTF8_H_COMMON
+#define UTF8_H_COMMON
+
+
+/* The errors that the lookup tables flag. */
+#define UTF8_TOO_SHORT   (1 << 0)
+#define UTF8_TOO_LONG    (1 << 1)
+#define UTF8_OVERLONG_3  (1 << 2)
+#define UTF8_TOO_LARGE   (1 << 3)
+#define UTF8_SURROGATE   (1 << 4)
+#define UTF8_OVERLONG_2  (1 << 5)
+#define UTF8_TOO_LARGE2  (1 << 6)
+#define UTF8_OVERLONG_4  (1 << 6)
+#define UTF8_TWO_CONTS   (1 << 7)
+#define UTF8_CARRY       (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+#define UTF8_LARGE       (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE2)
+#define UTF8_CONT        (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS)
+
+/**
+ * Repeat a 16-byte table four times, so that
+ * it can be loaded into a block of any width.
+ */
+#define UTF8_TABLE(...)  { __VA_ARGS__, __VA_ARGS__, __VA_ARGS__, __VA_ARGS__ }
+
+
+/**
+ * The errors that a byte, selected by its high
+ * nibble, could be part of if it is followed by
+ * a byte in the block.
+ */
+__attribute__((__unused__))
+static const unsigned char utf8_lead_high[64] = UTF8_TABLE
+  (UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+   UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+   UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+   UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+   UTF8_TOO_SHORT,
+   UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+   UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE2 | UTF8_OVERLONG_4);
+
+/**
+ * The errors that a byte, selected by its low
+ * nibble, could be part of if it is followed by
+ * a byte in the block.
+ */
+__attribute__((__unused__))
+static const unsigned char utf8_lead_low[64] = UTF8_TABLE
+  (UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+   UTF8_CARRY | UTF8_OVERLONG_2,
+   UTF8_CARRY, UTF8_CARRY,
+   UTF8_CARRY | UTF8_TOO_LARGE,
+   UTF8_LARGE, UTF8_LARGE, UTF8_LARGE,
+   UTF8_LARGE, UTF8_LARGE, UTF8_LARGE, UTF8_LARGE, UTF8_LARGE,
+   UTF8_LARGE | UTF8_SURROGATE,
+   UTF8_LARGE, UTF8_LARGE);
+
+/**
+ * The errors that a byte in the block, selected
+ * by its high nibble, could be part of.
+ */
+__attribute__((__unused__))
+static const unsigned char utf8_follow_high[64] = UTF8_TABLE
+  (UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+   UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+   UTF8_CONT | UTF8_OVERLONG_3 | UTF8_TOO_LARGE2 | UTF8_OVERLONG_4,
+   UTF8_CONT | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+   UTF8_CONT | UTF8_SURROGATE | UTF8_TOO_LARGE,
+   UTF8_CONT | UTF8_SURROGATE | UTF8_TOO_LARGE,
+   UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+
+
+/**
+ * Validate UTF-8 a character at a time.
+ * 
+ * @param   s     The input.
+ * @param   i     The position of the first character
+ *                to validate, must not be in the middle
+ *                of a character.
+ * @param   end   Characters are validated until one
+ *                ends at or after this position.
+ * @param   size  The size of the input, a character
+ *                may not extend past this position.
+ * @return        The position after the last validated
+ *                character, which is at least `end`,
+ *                or, if it is less than `end`, the
+ *                position of the first invalid or
+ *                incomplete character.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+utf8_decode(const unsigned char* s, size_t i, size_t end, size_t size)
+{
+  unsigned char c;
+  size_t n;
+  
+  while (i < end)
+    {
+      c = s[i];
+      if (c < 0x80)
+	{
+	  i++;
+	  continue;
+	}
+      n = c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : c < 0xF5 ? 4 : 0;
+      if (!n || size - i < n || (s[i + 1] & 0xC0) != 0x80)
+	return i;
+      if (n > 2)
+	{
+	  if ((s[i + 2] & 0xC0) != 0x80)
+	    return i;
+	  if ((c == 0xE0 && s[i + 1] < 0xA0) || (c == 0xED && s[i + 1] > 0x9F) ||
+	      (c == 0xF0 && s[i + 1] < 0x90) || (c == 0xF4 && s[i + 1] > 0x8F))
+	    return i;
+	  if (n > 3 && (s[i + 3] & 0xC0) != 0x80)
+	    return i;
+	}
+      i += n;
+    }
+  return i;
+}
+
+
+/**
+ * Find the start of the character that contains the byte
+ * before a position, if the character is not complete
+ * before the position, assuming that the input before
+ * that character is valid UTF-8.
+ * 
+ * @param   s  The input.
+ * @param   i  The position, at least 3.
+ * @return     The position of the first byte of the
+ *             character, at most 4 bytes before `i`,
+ *             or `i` if it is not a lead byte.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+utf8_start(const unsigned char* s, size_t i)
+{
+  size_t j = i;
+  while (j > i - 3 && (s[j - 1] & 0xC0) == 0x80)
+    j--;
+  return s[j - 1] >= 0xC0 ? j - 1 : i;
+}
+
+
+#endif
+
+
+
+/**
+ * Get the length of the longest prefix of
+ * a memory segment that is valid UTF-8.
+ * 
+ * @param   s     The memory segment.
+ * @param   size  The size of the memory segment.
+ * @return        The length of the longest valid prefix,
+ *                `size` iff the segment is valid UTF-8.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+SIMD(utf8_valid)(const char* s, size_t size)
+{
+  const unsigned char* u = (const unsigned char*)s;
+  simd_t high = SIMD_SPLAT(0x80);
+  size_t i, end = size < 3 ? size : 3;
+  simd_t v;
+#ifdef SIMD_SHUFFLE
+  simd_t lead_high = SIMD_LOADU(utf8_lead_high);
+  simd_t lead_low = SIMD_LOADU(utf8_lead_low);
+  simd_t follow_high = SIMD_LOADU(utf8_follow_high);
+  simd_t p1, p2, p3, error;
+#endif
+  
+  /* The first block is loaded at a position where
+   * the three bytes before it are readable. */
+  i = utf8_decode(u, 0, end, size);
+  if (i < end || i == size)
+    return i;
+  
+  while (i + SIMD_WIDTH <= size)
+    {
+      v = SIMD_LOADU(s + i);
+      if (SIMD_ZERO(v & high) == SIMD_ALL)
+	{
+	  /* A character that started before the block
+	   * continues into it, if there is one. */
+	  if (u[i - 1] >= 0xC0 || u[i - 2] >= 0xE0 || u[i - 3] >= 0xF0)
+	    break;
+	  i += SIMD_WIDTH;
+	  continue;
+	}
+#ifdef SIMD_SHUFFLE
+      p1 = SIMD_LOADU(s + i - 1);
+      p2 = SIMD_LOADU(s + i - 2);
+      p3 = SIMD_LOADU(s + i - 3);
+      error  = SIMD_SHUFFLE(lead_high, (p1 >> 4) & (char)0x0F);
+      error &= SIMD_SHUFFLE(lead_low, p1 & (char)0x0F);
+      error &= SIMD_SHUFFLE(follow_high, (v >> 4) & (char)0x0F);
+      error ^= (simd_t)(((p2 & (char)0xE0) == (char)0xE0) |
+			((p3 & (char)0xF0) == (char)0xF0)) & high;
+      if (SIMD_ZERO(error) != SIMD_ALL)
+	break;
+      i += SIMD_WIDTH;
+#else
+      end = i + SIMD_WIDTH;
+      i = utf8_decode(u, i, end, size);
+      if (i < end)
+	return i;
+#endif
+    }
+  
+  return utf8_decode(u, utf8_start(u, i), size, size);
+}
+
+
+/**
+ * Count the characters in a memory segment
+ * that contains UTF-8, by counting the bytes
+ * that are not continuation bytes.
+ * 
+ * @param   s     The memory segment.
+ * @param   size  The size of the memory segment.
+ * @return        The number of characters in `s`.
+ */
+__attribute__((__pure__, __unused__))
+static size_t
+SIMD(utf8_count)(const char* s, size_t size)
+{
+  simd_t mask = SIMD_SPLAT(0xC0), cont = SIMD_SPLAT(0x80);
+  const char* block = SIMD_ALIGN(s);
+  size_t left = size + (size_t)(s - block);
+  size_t n, blocks;
+  simd_mask_t m;
+  simd_t tally;
+  
+  if (!size)
+    return 0;
+  if (left < size)
+    left = SIZE_MAX;
+  
+  m = SIMD_FROM(SIMD_EQ(SIMD_LOAD(block) & mask, cont), (size_t)(s - block));
+  if (left <= SIMD_WIDTH)
+    return size - SIMD_COUNT(SIMD_UPTO(m, left - 1));
+  n = SIMD_COUNT(m);
+  block += SIMD_WIDTH;
+  left -= SIMD_WIDTH;
+  
+  while (left > SIMD_WIDTH)
+    {
+      blocks = (left - 1) / SIMD_WIDTH;
+      if (blocks > SCAN_TALLY_MAX)
+	blocks = SCAN_TALLY_MAX;
+      left -= blocks * SIMD_WIDTH;
+      tally = SIMD_SPLAT(0);
+      for (; blocks--; block += SIMD_WIDTH)
+	tally += SIMD_TALLY(SIMD_LOAD(block) & mask, cont);
+      n += SIMD(scan_sum)(tally);
+    }
+  
+  n += SIMD_COUNT(SIMD_UPTO(SIMD_EQ(SIMD_LOAD(block) & mask, cont), left - 1));
+  return size - n;
+}
+
@@ -0,0 +1,41 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Get the length of the longest prefix of a
+ * memory segment that is valid UTF-8. This is
+ * the position of the first invalid character,
+ * or of the character that is cut off at the
+ * end of the segment.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           The length of the longest valid prefix,
+ *                   `size` iff `segment` is valid UTF-8.
+ * 
+ * @since  Always.
+ */
+size_t utf8_prefix_valid(const void* segment, size_t size)
+{
+  return DISPATCH(utf8_valid)(segment, size);
+}
+
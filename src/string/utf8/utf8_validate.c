@@ -0,0 +1,40 @@
+/**
+ * slibc — Yet another C library
+ * Copyright © 2015, 2016  Mattias Andrée (m@maandree.se)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "../dispatch.h"
+
+
+
+/**
+ * Check whether a memory segment is valid UTF-8.
+ * 
+ * Overlong encodings, surrogates, characters above
+ * U+10FFFF, and characters that are cut off at the
+ * end of the segment are invalid.
+ * 
+ * @param   segment  The memory segment.
+ * @param   size     The size of the memory segment.
+ * @return           1 if `segment` is valid UTF-8, 0 otherwise.
+ * 
+ * @since  Always.
+ */
+int utf8_validate(const void* segment, size_t size)
+{
+  return DISPATCH(utf8_valid)(segment, size) == size;
+}
+
@@ -17,11 +17,13 @@
  */
 #include <strings.h>
 #include <string.h>
+#include "../string/dispatch.h"
 
 
 
 /**
- * This function is identical to `memcmp`.
+ * This function is similar to `memcmp`, but only
+ * reports whether the segments differ, not how.
  * 
  * @etymology  (B)ytes: (c)o(mp)are.
  * 
@@ -29,6 +31,6 @@
  */
 int bcmp(const void* a, const void* b, size_t size)
 {
-  return memcmp(a, b, size);
+  return DISPATCH(compare_bcmp)(a, b, size);
 }
 
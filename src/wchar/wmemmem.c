@@ -16,8 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <wchar.h>
-#include <unistd.h>
-#include <alloca.h>
+#include <stdint.h>
 
 
 
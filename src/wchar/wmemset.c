@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <wchar.h>
+#include "../string/dispatch.h"
 
 
 
@@ -31,9 +32,9 @@
  */
 wchar_t* wmemset(wchar_t* segment, wchar_t c, size_t size)
 {
-  wchar_t* r = segment;
-  while (size--)
-    *segment++ = c;
-  return r;
+  char pattern[COPY_PATTERN_SIZE];
+  copy_pattern(pattern, (const char*)&c, sizeof(c));
+  DISPATCH(copy_memset_pattern)((char*)segment, pattern, sizeof(c), size * sizeof(c));
+  return segment;
 }
 